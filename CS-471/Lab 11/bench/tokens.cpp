@@ -0,0 +1,60 @@
+// Benchmark driver for the Lab 11 interpreter's token buffer: includes compiler.cpp, lexes the file given
+// as the first argument, then parses and executes it, and prints the time of each phase, the token count
+// and the peak RSS. tokens.sh also builds it against older revisions of compiler.cpp: LAB11_SOURCE names
+// the file to include, and LAB11_SYMBOL_TABLE selects the SymbolTable those revisions ran on instead of
+// the Frame of variable slots.
+#include <sys/resource.h>
+#include <chrono>
+#include <sstream>
+
+#ifndef LAB11_SOURCE
+#define LAB11_SOURCE "../compiler.cpp"
+#endif
+#define main labMain
+#include LAB11_SOURCE
+#undef main
+
+// Milliseconds since start
+static double msSince(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "Usage: " << argv[0] << " FILE" << endl;
+        return 1;
+    }
+    ifstream file(argv[1]);
+    if (!file)
+    {
+        cerr << "Cannot open " << argv[1] << endl;
+        return 1;
+    }
+    stringstream buffer;
+    buffer << file.rdbuf();
+
+    StringInterner names;
+    Lexer lexer(buffer.str(), names);
+    auto start = chrono::steady_clock::now();
+    auto tokens = lexer.tokenize(); // vector<Token> before the TokenBuffer, TokenBuffer since
+    double lexMs = msSince(start);
+
+#ifdef LAB11_SYMBOL_TABLE
+    SymbolTable frame;
+#else
+    Frame frame(names.size());
+#endif
+    Parser parser(tokens, frame);
+    start = chrono::steady_clock::now();
+    parser.parseProgram();
+    double runMs = msSince(start);
+
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    cerr << tokens.size() << " tokens, lex " << lexMs << " ms, parse/execute " << runMs << " ms, peak RSS "
+         << usage.ru_maxrss / 1024 << " MB" << endl;
+    return 0;
+}
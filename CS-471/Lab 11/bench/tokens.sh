@@ -0,0 +1,41 @@
+#!/bin/sh
+# Benchmark for the Lab 11 interpreter: builds tokens.cpp and runs it on a generated program of
+# STATEMENTS straight-line statements (lexing dominates) and on a while loop of ITERATIONS iterations
+# (re-executing the same tokens dominates). The same driver is built against two revisions of
+# compiler.cpp taken from git, so the token layouts can be compared:
+#   aos      9ce7b8b^  tokens in a vector<Token> (one struct with a std::string per token)
+#   soa      9ce7b8b   the struct-of-arrays TokenBuffer, same SymbolTable as aos
+#   current  the working tree (TokenBuffer and the later changes, a Frame instead of the SymbolTable)
+# Without git only the current version is measured.
+# Usage: sh tokens.sh [STATEMENTS [ITERATIONS]]        (300000 and 2000000 by default; CXX picks the compiler)
+cd "$(dirname "$0")" || exit 1
+STATEMENTS=${1:-300000}
+ITERATIONS=${2:-2000000}
+CXX=${CXX:-g++}
+work=$(mktemp -d) || exit 1
+trap 'rm -rf "$work"' EXIT
+$CXX -std=c++17 -O2 -pthread -o "$work/current" tokens.cpp || exit 1
+versions=current
+# build NAME REVISION: builds the driver against compiler.cpp as of REVISION
+build() {
+    git show "$2:CS-471/Lab 11/compiler.cpp" > "$work/$1.cpp" 2> /dev/null || return 1
+    $CXX -std=c++17 -O2 -pthread -DLAB11_SYMBOL_TABLE -DLAB11_SOURCE="\"$work/$1.cpp\"" -o "$work/$1" tokens.cpp
+}
+if build aos 9ce7b8b^ && build soa 9ce7b8b; then
+    versions="aos soa current"
+else
+    echo "git revisions not available, measuring the current version only"
+fi
+
+awk -v n="$STATEMENTS" 'BEGIN {
+    print "int a = 1;"; print "int b = 2;"
+    for (i = 0; i < n; i++) print (i % 2 ? "b = a - 1; // b stays 2" : "a = b * 3 - b * 2 + b / 2;")
+}' > "$work/statements.txt"
+printf 'int i = 0;\nint sum = 0;\nwhile (i < %s) {\n    sum = i - sum;\n    i = i + 1;\n}\n' "$ITERATIONS" > "$work/loop.txt"
+
+for input in statements loop; do
+    for version in $versions; do
+        printf '%-10s %-8s ' "$input" "$version"
+        "$work/$version" "$work/$input.txt" > /dev/null || exit 1
+    done
+done
@@ -2,8 +2,14 @@
 #include <vector>
 #include <string>
 #include <cctype>
-#include <map>
+#include <unordered_map>
+#include <deque>
+#include <string_view>
+#include <cstdint>
+#include <climits>
 #include <fstream>
+#include <algorithm>
+#include <thread>
 
 using namespace std;
 
@@ -36,39 +42,284 @@ enum TokenType
     T_EOF,
 };
 
-struct Token
+/*
+    StringInterner gives every distinct identifier a dense id, in order of first appearance.
+    The lexer interns each identifier once, and the id is then the variable's slot in the Frame, so
+    running a loop body reads and writes variables by array index instead of hashing or comparing names.
+    names never moves its strings (deque), so the string_view keys in ids stay valid.
+*/
+class StringInterner
 {
-    TokenType type;
-    string value;
-    int line;
+public:
+    uint32_t intern(string_view text)
+    {
+        auto it = ids.find(text);
+        if (it != ids.end())
+            return it->second;
+        uint32_t id = static_cast<uint32_t>(names.size());
+        names.emplace_back(text);
+        ids.emplace(names.back(), id);
+        return id;
+    }
+
+    const string &name(uint32_t id) const
+    {
+        return names[id];
+    }
+
+    size_t size() const
+    {
+        return names.size();
+    }
+
+private:
+    deque<string> names;
+    unordered_map<string_view, uint32_t> ids;
 };
 
-struct Symbol
+/*
+    TokenBuffer keeps the tokens as parallel arrays (struct of arrays) instead of a vector of Token structs.
+    - kinds: one byte per token, so the parser's lookahead checks walk a dense byte array.
+    - offsets: where each token starts in the source; text(i) re-reads the lexeme from there on demand.
+    - payloads: the interned name of a T_ID token (see StringInterner), the value of a T_NUM token
+      (decoded once by the lexer), 0 for every other token.
+    - Line numbers are not stored per token. The lexer records the offset of every line break it counts,
+      and line(i) finds a token's line with a binary search, only when a message needs it.
+    The buffer views the Lexer's copy of the source, so the Lexer must outlive it.
+*/
+class TokenBuffer
 {
-    int value;
+private:
+    string_view src;
+    vector<uint8_t> kinds;
+    vector<uint32_t> offsets;
+    vector<uint32_t> payloads;
+    vector<uint32_t> lineBreaks;
+
+    static_assert(T_EOF <= UINT8_MAX, "token kinds must fit in a byte");
+
+public:
+    TokenBuffer(string_view src) : src(src) {}
+
+    size_t size() const
+    {
+        return kinds.size();
+    }
+
+    TokenType kind(size_t i) const
+    {
+        return static_cast<TokenType>(kinds[i]);
+    }
+
+    uint32_t id(size_t i) const
+    {
+        return payloads[i];
+    }
+
+    int number(size_t i) const
+    {
+        return static_cast<int>(payloads[i]);
+    }
+
+    string_view text(size_t i) const
+    {
+        size_t start = offsets[i];
+        size_t end = start;
+        switch (kind(i))
+        {
+        case T_EOF:
+            break;
+        case T_EQ:
+        case T_NEQ:
+        case T_LTE:
+        case T_GTE:
+            end += 2;
+            break;
+        case T_NUM:
+            while (end < src.size() && isdigit(src[end]))
+                end++;
+            break;
+        default:
+            if (isalpha(src[start]))
+            {
+                while (end < src.size() && isalnum(src[end]))
+                    end++;
+            }
+            else
+                end++;
+        }
+        return src.substr(start, end - start);
+    }
+
+    int line(size_t i) const
+    {
+        return 1 + static_cast<int>(upper_bound(lineBreaks.begin(), lineBreaks.end(), offsets[i]) - lineBreaks.begin());
+    }
+
+    void push(TokenType kind, size_t offset, uint32_t payload = 0)
+    {
+        kinds.push_back(static_cast<uint8_t>(kind));
+        offsets.push_back(static_cast<uint32_t>(offset));
+        payloads.push_back(payload);
+    }
+
+    void addLineBreak(size_t offset)
+    {
+        lineBreaks.push_back(static_cast<uint32_t>(offset));
+    }
+
+    // Appends the tokens and line breaks of part, the buffer of the chunk that follows this one,
+    // translating its T_ID ids through globalId.
+    void append(const TokenBuffer &part, const vector<uint32_t> &globalId)
+    {
+        kinds.insert(kinds.end(), part.kinds.begin(), part.kinds.end());
+        offsets.insert(offsets.end(), part.offsets.begin(), part.offsets.end());
+        for (size_t i = 0; i < part.size(); i++)
+            payloads.push_back(part.kind(i) == T_ID ? globalId[part.payloads[i]] : part.payloads[i]);
+        lineBreaks.insert(lineBreaks.end(), part.lineBreaks.begin(), part.lineBreaks.end());
+    }
+
+    void reserve(size_t tokenCount)
+    {
+        kinds.reserve(tokenCount);
+        offsets.reserve(tokenCount);
+        payloads.reserve(tokenCount);
+    }
 };
 
 class Lexer
 {
 private:
     string src;
-    size_t pos;
-    int line;
+    StringInterner &names;
+
+    // Smallest chunk worth giving to its own thread; below this the thread start-up costs more than it saves.
+    static const size_t MIN_PARALLEL_CHUNK = 1 << 20;
+
+    // Lexer state at the start of a line: either between tokens, or inside a block comment.
+    // (A // comment always ends at the newline, so it never carries over to the next line.)
+    enum ChunkState
+    {
+        OUTSIDE_COMMENT = 0,
+        INSIDE_COMMENT = 1
+    };
 
 public:
-    Lexer(const string &src) : src(src), pos(0), line(1) {}
+    Lexer(const string &src, StringInterner &names) : src(src), names(names)
+    {
+        if (src.size() > UINT32_MAX)
+        {
+            cout << "Source too large: token offsets are 32 bits" << endl;
+            exit(1);
+        }
+    }
 
-    vector<Token> tokenize()
+    TokenBuffer tokenize()
     {
-        vector<Token> tokens;
-        while (pos < src.size())
+        TokenBuffer tokens(src);
+        size_t errorPos = lexRange(0, src.size(), OUTSIDE_COMMENT, names, tokens);
+        if (errorPos != string::npos)
+            reportError(errorPos);
+        tokens.push(T_EOF, src.size());
+        return tokens;
+    }
+
+    /*
+        tokenizeParallel lexes the source with up to threadCount threads and returns exactly the
+        tokens that tokenize() returns.
+        1. The source is cut into chunks that start right after a newline.
+        2. Pre-pass (in parallel): each chunk is scanned for comment markers only, once assuming it
+           starts outside a comment and once assuming it starts inside a block comment. This gives the
+           state at the end of the chunk.
+        3. Walking the chunks in order, the real start state of every chunk follows from the previous
+           chunk's end state.
+        4. Each chunk is lexed on its own thread from its known state, interning its identifiers into
+           a chunk-local StringInterner. Line breaks are recorded as source offsets, so a chunk does
+           not need to know its start line.
+        5. The per-chunk token buffers are joined in order, and each chunk's local ids are mapped to
+           global ids by interning the chunk's names in local id order, which gives every identifier
+           the same id as a serial tokenize() would.
+    */
+    TokenBuffer tokenizeParallel(unsigned threadCount)
+    {
+        size_t chunkCount = min<size_t>(max(threadCount, 1u), src.size() / MIN_PARALLEL_CHUNK);
+        if (chunkCount < 2)
+            return tokenize();
+
+        vector<size_t> bounds{0};
+        for (size_t k = 1; k < chunkCount; k++)
+        {
+            size_t cut = src.find('\n', max(k * src.size() / chunkCount, bounds.back()));
+            if (cut == string::npos || cut + 1 >= src.size())
+                break;
+            bounds.push_back(cut + 1);
+        }
+        bounds.push_back(src.size());
+        size_t chunks = bounds.size() - 1;
+
+        vector<ChunkState> endStates(2 * chunks);
+        runOnThreads(chunks, [&](size_t k)
+        {
+            endStates[2 * k] = summarizeChunk(bounds[k], bounds[k + 1], OUTSIDE_COMMENT);
+            endStates[2 * k + 1] = summarizeChunk(bounds[k], bounds[k + 1], INSIDE_COMMENT);
+        });
+
+        vector<ChunkState> startState(chunks);
+        ChunkState state = OUTSIDE_COMMENT;
+        for (size_t k = 0; k < chunks; k++)
+        {
+            startState[k] = state;
+            state = endStates[2 * k + state];
+        }
+
+        vector<TokenBuffer> parts(chunks, TokenBuffer(src));
+        vector<StringInterner> localNames(chunks);
+        vector<size_t> errors(chunks, string::npos);
+        runOnThreads(chunks, [&](size_t k)
+        {
+            errors[k] = lexRange(bounds[k], bounds[k + 1], startState[k], localNames[k], parts[k]);
+        });
+
+        TokenBuffer tokens(src);
+        size_t total = 0;
+        for (const TokenBuffer &part : parts)
+            total += part.size();
+        tokens.reserve(total + 1);
+        for (size_t k = 0; k < chunks; k++)
+        {
+            if (errors[k] != string::npos)
+                reportError(errors[k]);
+            vector<uint32_t> globalId(localNames[k].size());
+            for (uint32_t id = 0; id < globalId.size(); id++)
+                globalId[id] = names.intern(localNames[k].name(id));
+            tokens.append(parts[k], globalId);
+        }
+        tokens.push(T_EOF, src.size());
+        return tokens;
+    }
+
+private:
+    /*
+        Lexes the tokens that start in [begin, end) and appends them to tokens, interning identifiers
+        into ids. state is the lexer state at begin. A block comment may run past end,
+        and then the next chunk starts inside it.
+        Returns the position of an unexpected character or of an integer literal that does not fit
+        in an int, or string::npos if there was neither.
+    */
+    size_t lexRange(size_t begin, size_t end, ChunkState state, StringInterner &ids, TokenBuffer &tokens) const
+    {
+        size_t pos = begin;
+        if (state == INSIDE_COMMENT)
+            pos = skipCommentBody(pos);
+
+        while (pos < end)
         {
             char current = src[pos];
 
             if (isspace(current))
             {
                 if (current == '\n')
-                    line++;
+                    tokens.addLineBreak(pos);
                 pos++;
                 continue;
             }
@@ -77,12 +328,12 @@ public:
             {
                 if (src[pos + 1] == '/')
                 {
-                    skipSingleLineComment();
+                    pos = skipSingleLineComment(pos);
                     continue;
                 }
                 else if (src[pos + 1] == '*')
                 {
-                    skipMultiLineComment();
+                    pos = skipMultiLineComment(pos);
                     continue;
                 }
             }
@@ -90,9 +341,16 @@ public:
             if (isdigit(current))
             {
                 size_t start = pos;
+                uint32_t value = 0;
                 while (pos < src.size() && isdigit(src[pos]))
+                {
+                    uint32_t digit = src[pos] - '0';
+                    if (value > (INT_MAX - digit) / 10)
+                        return start;
+                    value = value * 10 + digit;
                     pos++;
-                tokens.push_back(Token{T_NUM, src.substr(start, pos - start), line});
+                }
+                tokens.push(T_NUM, start, value);
                 continue;
             }
 
@@ -101,21 +359,21 @@ public:
                 size_t start = pos;
                 while (pos < src.size() && isalnum(src[pos]))
                     pos++;
-                string word = src.substr(start, pos - start);
+                string_view word(src.data() + start, pos - start);
                 if (word == "int")
-                    tokens.push_back(Token{T_INT, word, line});
+                    tokens.push(T_INT, start);
                 else if (word == "if")
-                    tokens.push_back(Token{T_IF, word, line});
+                    tokens.push(T_IF, start);
                 else if (word == "else")
-                    tokens.push_back(Token{T_ELSE, word, line});
+                    tokens.push(T_ELSE, start);
                 else if (word == "return")
-                    tokens.push_back(Token{T_RETURN, word, line});
+                    tokens.push(T_RETURN, start);
                 else if (word == "while")
-                    tokens.push_back(Token{T_WHILE, word, line});
+                    tokens.push(T_WHILE, start);
                 else if (word == "for")
-                    tokens.push_back(Token{T_FOR, word, line});
+                    tokens.push(T_FOR, start);
                 else
-                    tokens.push_back(Token{T_ID, word, line});
+                    tokens.push(T_ID, start, ids.intern(word));
                 continue;
             }
 
@@ -124,145 +382,205 @@ public:
             case '=':
                 if (pos + 1 < src.size() && src[pos + 1] == '=')
                 {
-                    tokens.push_back(Token{T_EQ, "==", line});
+                    tokens.push(T_EQ, pos);
                     pos++;
                 }
                 else
-                    tokens.push_back(Token{T_ASSIGN, "=", line});
+                    tokens.push(T_ASSIGN, pos);
                 break;
             case '!':
                 if (pos + 1 < src.size() && src[pos + 1] == '=')
                 {
-                    tokens.push_back(Token{T_NEQ, "!=", line});
+                    tokens.push(T_NEQ, pos);
                     pos++;
                 }
                 break;
             case '<':
                 if (pos + 1 < src.size() && src[pos + 1] == '=')
                 {
-                    tokens.push_back(Token{T_LTE, "<=", line});
+                    tokens.push(T_LTE, pos);
                     pos++;
                 }
                 else
-                    tokens.push_back(Token{T_LT, "<", line});
+                    tokens.push(T_LT, pos);
                 break;
             case '>':
                 if (pos + 1 < src.size() && src[pos + 1] == '=')
                 {
-                    tokens.push_back(Token{T_GTE, ">=", line});
+                    tokens.push(T_GTE, pos);
                     pos++;
                 }
                 else
-                    tokens.push_back(Token{T_GT, ">", line});
+                    tokens.push(T_GT, pos);
                 break;
             case '+':
-                tokens.push_back(Token{T_PLUS, "+", line});
+                tokens.push(T_PLUS, pos);
                 break;
             case '-':
-                tokens.push_back(Token{T_MINUS, "-", line});
+                tokens.push(T_MINUS, pos);
                 break;
             case '*':
-                tokens.push_back(Token{T_MUL, "*", line});
+                tokens.push(T_MUL, pos);
                 break;
             case '/':
-                tokens.push_back(Token{T_DIV, "/", line});
+                tokens.push(T_DIV, pos);
                 break;
             case '(':
-                tokens.push_back(Token{T_LPAREN, "(", line});
+                tokens.push(T_LPAREN, pos);
                 break;
             case ')':
-                tokens.push_back(Token{T_RPAREN, ")", line});
+                tokens.push(T_RPAREN, pos);
                 break;
             case '{':
-                tokens.push_back(Token{T_LBRACE, "{", line});
+                tokens.push(T_LBRACE, pos);
                 break;
             case '}':
-                tokens.push_back(Token{T_RBRACE, "}", line});
+                tokens.push(T_RBRACE, pos);
                 break;
             case ';':
-                tokens.push_back(Token{T_SEMICOLON, ";", line});
+                tokens.push(T_SEMICOLON, pos);
                 break;
             default:
-                cout << "Unexpected character: " << current << endl;
-                exit(1);
+                return pos;
             }
             pos++;
         }
-        tokens.push_back(Token{T_EOF, "", line});
-        return tokens;
+        return string::npos;
     }
 
-private:
-    void skipSingleLineComment()
+    // Prints the error lexRange stopped at and exits.
+    void reportError(size_t pos) const
+    {
+        if (isdigit(src[pos]))
+        {
+            size_t end = pos;
+            while (end < src.size() && isdigit(src[end]))
+                end++;
+            cout << "Integer literal out of range: " << src.substr(pos, end - pos) << endl;
+        }
+        else
+            cout << "Unexpected character: " << src[pos] << endl;
+        exit(1);
+    }
+
+    size_t skipSingleLineComment(size_t pos) const
     {
         while (pos < src.size() && src[pos] != '\n')
         {
             pos++;
         }
+        return pos;
     }
 
-    void skipMultiLineComment()
+    size_t skipMultiLineComment(size_t pos) const
+    {
+        return skipCommentBody(pos + 2);
+    }
+
+    // Skips to just past the "*/" that closes the comment pos is in (or to the end of the source).
+    size_t skipCommentBody(size_t pos) const
     {
-        pos += 2;
         while (pos < src.size())
         {
             if (src[pos] == '*' && pos + 1 < src.size() && src[pos + 1] == '/')
             {
-                pos += 2;
-                break;
+                return pos + 2;
             }
             pos++;
         }
+        return pos;
+    }
+
+    // Pre-pass for tokenizeParallel: follows only comments through [begin, end), exactly the way
+    // lexRange would, starting from the given state, and returns the state at end.
+    ChunkState summarizeChunk(size_t begin, size_t end, ChunkState state) const
+    {
+        size_t pos = begin;
+        if (state == INSIDE_COMMENT)
+            pos = skipCommentBody(pos);
+        while (pos < end)
+        {
+            char current = src[pos];
+            if (current == '/' && pos + 1 < src.size())
+            {
+                if (src[pos + 1] == '/')
+                {
+                    pos = skipSingleLineComment(pos);
+                    continue;
+                }
+                if (src[pos + 1] == '*')
+                {
+                    pos = skipMultiLineComment(pos);
+                    continue;
+                }
+            }
+            pos++;
+        }
+        // Ending past the chunk means a block comment is still open at the chunk boundary.
+        return pos > end ? INSIDE_COMMENT : OUTSIDE_COMMENT;
+    }
+
+    // Calls work(0) .. work(count - 1), each on its own thread (work(0) on the calling thread).
+    template <typename Work>
+    static void runOnThreads(size_t count, Work work)
+    {
+        vector<thread> threads;
+        for (size_t k = 1; k < count; k++)
+            threads.emplace_back(work, k);
+        work(0);
+        for (thread &t : threads)
+            t.join();
     }
 };
 
-class SymbolTable
+/*
+    Frame holds the values of the program's variables in one contiguous array of int64_t slots.
+    Every variable is resolved to a fixed slot before execution starts: the lexer has already interned
+    each identifier to a dense id (see StringInterner) and stored it in its T_ID token, so that id is the
+    slot index, and the frame is sized once, from the number of distinct names, before the first statement
+    runs. Reading or writing a variable is then one array access; nothing is hashed or searched at run time.
+    Values are ints. A slot holds UNASSIGNED, which no int can equal, until its variable is first given a
+    value, so reading a variable that was never assigned is still reported.
+*/
+class Frame
 {
 private:
-    map<string, Symbol> symbols;
+    static constexpr int64_t UNASSIGNED = INT64_MIN;
+    vector<int64_t> slots;
 
 public:
-    void addSymbol(const string &name, int value)
-    {
-        symbols[name] = {value};
-    }
+    explicit Frame(size_t slotCount) : slots(slotCount, UNASSIGNED) {}
 
-    bool getSymbolValue(const string &name, int &value)
+    bool get(uint32_t slot, int &value) const
     {
-        if (symbols.find(name) != symbols.end())
+        int64_t stored = slots[slot];
+        if (stored == UNASSIGNED)
         {
-            value = symbols[name].value;
-            return true;
+            return false;
         }
-        return false;
+        value = static_cast<int>(stored);
+        return true;
     }
 
-    void setSymbolValue(const string &name, int value)
+    void set(uint32_t slot, int value)
     {
-        if (symbols.find(name) != symbols.end())
-        {
-            symbols[name].value = value;
-        }
-        else
-        {
-            addSymbol(name, value);
-        }
+        slots[slot] = value;
     }
 };
 
 class Parser
 {
 private:
-    vector<Token> tokens;
+    const TokenBuffer &tokens; // lookahead only reads tokens.kind(); text and line are for messages
     size_t pos;
-    SymbolTable &symbolTable;
+    Frame &frame; // variable values, indexed by the slot in each T_ID token
 
 public:
-    Parser(const vector<Token> &tokens, SymbolTable &symbolTable) : tokens(tokens), pos(0), symbolTable(symbolTable) {}
+    Parser(const TokenBuffer &tokens, Frame &frame) : tokens(tokens), pos(0), frame(frame) {}
 
     void parseProgram()
     {
-        while (tokens[pos].type != T_EOF)
+        while (tokens.kind(pos) != T_EOF)
         {
             parseStatement();
         }
@@ -272,25 +590,25 @@ public:
 private:
     void parseStatement()
     {
-        if (tokens[pos].type == T_INT)
+        if (tokens.kind(pos) == T_INT)
         {
             parseDeclaration();
         }
-        else if (tokens[pos].type == T_ID)
+        else if (tokens.kind(pos) == T_ID)
         {
             parseAssignment();
         }
-        else if (tokens[pos].type == T_WHILE)
+        else if (tokens.kind(pos) == T_WHILE)
         {
             parseWhileLoop();
         }
-        else if (tokens[pos].type == T_FOR)
+        else if (tokens.kind(pos) == T_FOR)
         {
             parseForLoop();
         }
         else
         {
-            cout << "Syntax error at: " << tokens[pos].value << endl;
+            cout << "Syntax error at: " << tokens.text(pos) << endl;
             exit(1);
         }
     }
@@ -298,22 +616,22 @@ private:
     void parseDeclaration()
     {
         expect(T_INT);
-        string name = tokens[pos].value;
+        uint32_t id = tokens.id(pos);
         expect(T_ID);
         expect(T_ASSIGN);
         int value = parseExpression();
         expect(T_SEMICOLON);
-        symbolTable.addSymbol(name, value);
+        frame.set(id, value);
     }
 
     void parseAssignment()
     {
-        string name = tokens[pos].value;         // Get the variable name
-        expect(T_ID);                            // Expect an identifier
-        expect(T_ASSIGN);                        // Expect '='
-        int value = parseExpression();           // Parse and evaluate the expression
-        expect(T_SEMICOLON);                     // Expect ';'
-        symbolTable.setSymbolValue(name, value); // Update the symbol table
+        uint32_t id = tokens.id(pos);  // Get the variable's slot
+        expect(T_ID);                  // Expect an identifier
+        expect(T_ASSIGN);              // Expect '='
+        int value = parseExpression(); // Parse and evaluate the expression
+        expect(T_SEMICOLON);           // Expect ';'
+        frame.set(id, value);          // Store it in the variable's slot
     }
 
     void parseWhileLoop()
@@ -368,7 +686,7 @@ private:
     {
         expect(T_LBRACE); // Expect '{'
 
-        while (tokens[pos].type != T_RBRACE && tokens[pos].type != T_EOF)
+        while (tokens.kind(pos) != T_RBRACE && tokens.kind(pos) != T_EOF)
         {
             parseStatement(); // Parse and execute each statement in the block
         }
@@ -381,10 +699,10 @@ private:
         int left = parseExpression(); // Parse the left operand
 
         // Ensure the next token is a relational operator
-        if (tokens[pos].type == T_LT || tokens[pos].type == T_GT || tokens[pos].type == T_EQ ||
-            tokens[pos].type == T_NEQ || tokens[pos].type == T_LTE || tokens[pos].type == T_GTE)
+        if (tokens.kind(pos) == T_LT || tokens.kind(pos) == T_GT || tokens.kind(pos) == T_EQ ||
+            tokens.kind(pos) == T_NEQ || tokens.kind(pos) == T_LTE || tokens.kind(pos) == T_GTE)
         {
-            TokenType op = tokens[pos].type;
+            TokenType op = tokens.kind(pos);
             pos++; // Consume the relational operator
 
             int right = parseExpression(); // Parse the right operand
@@ -412,7 +730,7 @@ private:
         else
         {
             cout << "Syntax error: Expected relational operator but found '"
-                 << tokens[pos].value << "' on line " << tokens[pos].line << endl;
+                 << tokens.text(pos) << "' on line " << tokens.line(pos) << endl;
             exit(1);
         }
     }
@@ -422,55 +740,55 @@ private:
         // Parse the first operand
         int left = 0;
 
-        if (tokens[pos].type == T_NUM)
+        if (tokens.kind(pos) == T_NUM)
         {
-            left = stoi(tokens[pos].value); // Convert number token to an integer
-            pos++;                          // Move to the next token
+            left = tokens.number(pos); // Value the lexer decoded from the literal
+            pos++;                     // Move to the next token
         }
-        else if (tokens[pos].type == T_ID)
+        else if (tokens.kind(pos) == T_ID)
         {
-            string name = tokens[pos].value;
-            pos++;                                       // Move to the next token
-            if (!symbolTable.getSymbolValue(name, left)) // Get the variable value
+            size_t name = pos;
+            pos++;                                 // Move to the next token
+            if (!frame.get(tokens.id(name), left)) // Get the variable value from its slot
             {
-                cout << "Undefined variable: " << name << endl;
+                cout << "Undefined variable: " << tokens.text(name) << endl;
                 exit(1);
             }
         }
         else
         {
-            cout << "Unexpected token in expression: " << tokens[pos].value << endl;
+            cout << "Unexpected token in expression: " << tokens.text(pos) << endl;
             exit(1);
         }
 
         // Parse binary operators and their operands
-        while (tokens[pos].type == T_PLUS || tokens[pos].type == T_MINUS ||
-               tokens[pos].type == T_MUL || tokens[pos].type == T_DIV)
+        while (tokens.kind(pos) == T_PLUS || tokens.kind(pos) == T_MINUS ||
+               tokens.kind(pos) == T_MUL || tokens.kind(pos) == T_DIV)
         {
-            TokenType op = tokens[pos].type; // Capture the operator
+            TokenType op = tokens.kind(pos); // Capture the operator
             pos++;                           // Consume the operator
 
             // Parse the right operand
             int right = 0;
-            if (tokens[pos].type == T_NUM)
+            if (tokens.kind(pos) == T_NUM)
             {
-                right = stoi(tokens[pos].value);
+                right = tokens.number(pos);
                 pos++;
             }
-            else if (tokens[pos].type == T_ID)
+            else if (tokens.kind(pos) == T_ID)
             {
-                string name = tokens[pos].value;
+                size_t name = pos;
                 pos++;
-                if (!symbolTable.getSymbolValue(name, right))
+                if (!frame.get(tokens.id(name), right))
                 {
-                    cout << "Undefined variable: " << name << endl;
+                    cout << "Undefined variable: " << tokens.text(name) << endl;
                     exit(1);
                 }
             }
             else
             {
                 cout << "Syntax error: Expected number or identifier but found '"
-                     << tokens[pos].value << "' on line " << tokens[pos].line << endl;
+                     << tokens.text(pos) << "' on line " << tokens.line(pos) << endl;
                 exit(1);
             }
 
@@ -489,7 +807,7 @@ private:
             case T_DIV:
                 if (right == 0)
                 {
-                    cout << "Error: Division by zero on line " << tokens[pos].line << endl;
+                    cout << "Error: Division by zero on line " << tokens.line(pos) << endl;
                     exit(1);
                 }
                 left /= right;
@@ -505,13 +823,13 @@ private:
 
     void expect(TokenType type)
     {
-        if (tokens[pos].type == type)
+        if (tokens.kind(pos) == type)
         {
             pos++;
         }
         else
         {
-            cout << "Expected token type but found: " << tokens[pos].value << endl;
+            cout << "Expected token type but found: " << tokens.text(pos) << endl;
             exit(1);
         }
     }
@@ -527,11 +845,12 @@ int main()
     }
 )";
 
-    Lexer lexer(input);
-    vector<Token> tokens = lexer.tokenize();
+    StringInterner names;
+    Lexer lexer(input, names);
+    TokenBuffer tokens = lexer.tokenizeParallel(thread::hardware_concurrency()); // falls back to tokenize() for small inputs
 
-    SymbolTable symbolTable;
-    Parser parser(tokens, symbolTable);
+    Frame frame(names.size()); // one slot per distinct identifier, fixed before execution
+    Parser parser(tokens, frame);
     parser.parseProgram();
 
     return 0;
@@ -2,6 +2,16 @@
 #include <vector>
 #include <string>
 #include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <string_view>
+#include <algorithm>
+#include <chrono>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -33,6 +43,155 @@ struct Token
     string value;
 };
 
+// Token DFA generated by lexgen (Lab 14/lexgen.cpp) from compiler2.tokens: matchToken finds the longest
+// token at a position, keywords included, with one table lookup per byte.
+// Regenerate with: lexgen compiler2.tokens > compiler2_dfa.h
+#include "compiler2_dfa.h"
+
+/*
+    Fast skipping helpers used by the Lexer:
+    - skipSpace(s, i, n):      index of the first non-whitespace byte at or after i
+    - findNewline(s, i, n):    index of the first '\n' at or after i
+    - findCommentEnd(s, i, n): index of the first star that is directly followed by a slash
+    All of them return n when nothing is found. Each has a scalar version and, on x86-64, SSE2
+    (16 bytes per step) and AVX2 (32 bytes per step) versions. The fastest set the CPU supports is
+    chosen once at startup in selectScanKernels().
+*/
+static inline bool isSpaceByte(char c)
+{
+    return c == ' ' || static_cast<unsigned char>(c - '\t') <= 4; // ' ', \t, \n, \v, \f, \r
+}
+
+static size_t skipSpaceScalar(const char *s, size_t i, size_t n)
+{
+    while (i < n && isSpaceByte(s[i]))
+        i++;
+    return i;
+}
+
+static size_t findNewlineScalar(const char *s, size_t i, size_t n)
+{
+    while (i < n && s[i] != '\n')
+        i++;
+    return i;
+}
+
+static size_t findCommentEndScalar(const char *s, size_t i, size_t n)
+{
+    while (i + 1 < n && !(s[i] == '*' && s[i + 1] == '/'))
+        i++;
+    return i + 1 < n ? i : n;
+}
+
+#if defined(__GNUC__) && defined(__x86_64__)
+static size_t skipSpaceSSE2(const char *s, size_t i, size_t n)
+{
+    const __m128i space = _mm_set1_epi8(' '), tab = _mm_set1_epi8('\t'), four = _mm_set1_epi8(4);
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+        __m128i fromTab = _mm_sub_epi8(v, tab); // \t..\r become 0..4
+        __m128i isSpace = _mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(_mm_min_epu8(fromTab, four), fromTab));
+        unsigned stop = ~static_cast<unsigned>(_mm_movemask_epi8(isSpace)) & 0xFFFFu;
+        if (stop)
+            return i + __builtin_ctz(stop);
+    }
+    return skipSpaceScalar(s, i, n);
+}
+
+static size_t findNewlineSSE2(const char *s, size_t i, size_t n)
+{
+    const __m128i newline = _mm_set1_epi8('\n');
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+        unsigned hit = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline)));
+        if (hit)
+            return i + __builtin_ctz(hit);
+    }
+    return findNewlineScalar(s, i, n);
+}
+
+static size_t findCommentEndSSE2(const char *s, size_t i, size_t n)
+{
+    const __m128i star = _mm_set1_epi8('*'), slash = _mm_set1_epi8('/');
+    for (; i + 17 <= n; i += 16) // the second load reads one byte further
+    {
+        __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+        __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + 1));
+        unsigned hit = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(first, star), _mm_cmpeq_epi8(second, slash))));
+        if (hit)
+            return i + __builtin_ctz(hit);
+    }
+    return findCommentEndScalar(s, i, n);
+}
+
+__attribute__((target("avx2"))) static size_t skipSpaceAVX2(const char *s, size_t i, size_t n)
+{
+    const __m256i space = _mm256_set1_epi8(' '), tab = _mm256_set1_epi8('\t'), four = _mm256_set1_epi8(4);
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+        __m256i fromTab = _mm256_sub_epi8(v, tab);
+        __m256i isSpace = _mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(_mm256_min_epu8(fromTab, four), fromTab));
+        unsigned stop = ~static_cast<unsigned>(_mm256_movemask_epi8(isSpace));
+        if (stop)
+            return i + __builtin_ctz(stop);
+    }
+    return skipSpaceSSE2(s, i, n);
+}
+
+__attribute__((target("avx2"))) static size_t findNewlineAVX2(const char *s, size_t i, size_t n)
+{
+    const __m256i newline = _mm256_set1_epi8('\n');
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+        unsigned hit = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, newline)));
+        if (hit)
+            return i + __builtin_ctz(hit);
+    }
+    return findNewlineSSE2(s, i, n);
+}
+
+__attribute__((target("avx2"))) static size_t findCommentEndAVX2(const char *s, size_t i, size_t n)
+{
+    const __m256i star = _mm256_set1_epi8('*'), slash = _mm256_set1_epi8('/');
+    for (; i + 33 <= n; i += 32)
+    {
+        __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+        __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i + 1));
+        unsigned hit = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(first, star), _mm256_cmpeq_epi8(second, slash))));
+        if (hit)
+            return i + __builtin_ctz(hit);
+    }
+    return findCommentEndSSE2(s, i, n);
+}
+#endif
+
+struct ScanKernels
+{
+    size_t (*skipSpace)(const char *, size_t, size_t);
+    size_t (*findNewline)(const char *, size_t, size_t);
+    size_t (*findCommentEnd)(const char *, size_t, size_t);
+};
+
+static ScanKernels selectScanKernels()
+{
+#if defined(__GNUC__) && defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return ScanKernels{skipSpaceAVX2, findNewlineAVX2, findCommentEndAVX2};
+    return ScanKernels{skipSpaceSSE2, findNewlineSSE2, findCommentEndSSE2}; // SSE2 is part of every x86-64 CPU
+#else
+    return ScanKernels{skipSpaceScalar, findNewlineScalar, findCommentEndScalar};
+#endif
+}
+
+static const ScanKernels scan = selectScanKernels();
+
 class Lexer
 {
 private:
@@ -41,40 +200,15 @@ private:
 
     void skipSingleLineComment()
     {
-        while (pos < src.size() && src[pos] != '\n')
-        {
-            pos++;
-        }
+        pos = scan.findNewline(src.data(), pos, src.size());
     }
 
     void skipMultiLineComment()
     {
         pos += 2; // Skip initial /*
-        while (pos < src.size())
-        {
-            if (src[pos] == '*' && pos + 1 < src.size() && src[pos + 1] == '/')
-            {
-                pos += 2; // Skip closing */
-                break;
-            }
-            pos++;
-        }
-    }
-
-    string consumeNumber()
-    {
-        size_t start = pos;
-        while (pos < src.size() && isdigit(src[pos]))
-            pos++;
-        return src.substr(start, pos - start);
-    }
-
-    string consumeWord()
-    {
-        size_t start = pos;
-        while (pos < src.size() && isalnum(src[pos]))
-            pos++;
-        return src.substr(start, pos - start);
+        pos = scan.findCommentEnd(src.data(), pos, src.size());
+        if (pos < src.size())
+            pos += 2; // Skip closing */
     }
 
 public:
@@ -89,7 +223,7 @@ public:
 
             if (isspace(current))
             {
-                pos++;
+                pos = scan.skipSpace(src.data(), pos, src.size());
                 continue;
             }
 
@@ -107,68 +241,15 @@ public:
                 }
             }
 
-            if (isdigit(current))
+            size_t length;
+            int kind = matchToken(src.data() + pos, src.data() + src.size(), length);
+            if (kind < 0)
             {
-                tokens.push_back(Token{T_NUM, consumeNumber()});
-                continue;
-            }
-
-            if (isalpha(current))
-            {
-                string word = consumeWord();
-                if (word == "int")
-                    tokens.push_back(Token{T_INT, word});
-                else if (word == "if")
-                    tokens.push_back(Token{T_IF, word});
-                else if (word == "else")
-                    tokens.push_back(Token{T_ELSE, word});
-                else if (word == "return")
-                    tokens.push_back(Token{T_RETURN, word});
-                else
-                    tokens.push_back(Token{T_ID, word});
-                continue;
-            }
-
-            switch (current)
-            {
-            case '=':
-                tokens.push_back(Token{T_ASSIGN, "="});
-                break;
-            case '+':
-                tokens.push_back(Token{T_PLUS, "+"});
-                break;
-            case '-':
-                tokens.push_back(Token{T_MINUS, "-"});
-                break;
-            case '*':
-                tokens.push_back(Token{T_MUL, "*"});
-                break;
-            case '/':
-                tokens.push_back(Token{T_DIV, "/"});
-                break;
-            case '(':
-                tokens.push_back(Token{T_LPAREN, "("});
-                break;
-            case ')':
-                tokens.push_back(Token{T_RPAREN, ")"});
-                break;
-            case '{':
-                tokens.push_back(Token{T_LBRACE, "{"});
-                break;
-            case '}':
-                tokens.push_back(Token{T_RBRACE, "}"});
-                break;
-            case ';':
-                tokens.push_back(Token{T_SEMICOLON, ";"});
-                break;
-            case '>':
-                tokens.push_back(Token{T_GT, ">"});
-                break;
-            default:
                 cout << "Unexpected character: " << current << endl;
                 exit(1);
             }
-            pos++;
+            tokens.push_back(Token{static_cast<TokenType>(kind), src.substr(pos, length)});
+            pos += length;
         }
         tokens.push_back(Token{T_EOF, ""}); // Add EOF token at the end
         return tokens;
@@ -190,7 +271,7 @@ public:
     }
 
 private:
-    vector<Token> tokens;
+    const vector<Token> &tokens; // borrowed, not copied: the caller keeps the vector alive while parsing
     size_t pos;
 
     void parseStatement()
@@ -310,8 +391,386 @@ private:
     }
 };
 
-int main()
+/*
+    Tables for SyntaxChecker.
+
+    BYTE_CLASS and PUNCT_KIND classify every byte and give the token of every one-byte punctuator.
+    CHECK_TRANSITIONS is Parser's grammar as a table over token types: the entry for the current state and
+    the next token is the next state, or one of the actions past CHECK_STATES for the few tokens that open
+    or close a nesting level or end a statement. Expressions in if conditions have their own two states,
+    so the table alone knows whether ')' or ';' ends one.
+*/
+enum ByteClass : uint8_t
+{
+    B_LETTER,
+    B_DIGIT, // letters and digits first, so a word continues while the class is <= B_DIGIT
+    B_PUNCT,
+    B_SPACE,
+    B_OTHER
+};
+
+enum CheckState : uint8_t
 {
+    CS_STATEMENT,      // a statement starts here, or '}' closes a block, or the input ends
+    CS_BRANCH,         // the statement of an if or else starts here
+    CS_DECL_ID,        // int _
+    CS_DECL_SEMI,      // int x _
+    CS_ASSIGN_EQ,      // x _
+    CS_IF_LPAREN,      // if _
+    CS_OPERAND,        // an identifier or number in an assignment or return
+    CS_OPERATOR,       // an operator, or ';'
+    CS_COND_OPERAND,   // an identifier or number in an if condition
+    CS_COND_OPERATOR,  // an operator, or ')'
+    CS_AFTER_THEN,     // the statement of an if is complete: 'else', or the if is complete too
+    CHECK_STATES,
+    CA_ERROR = CHECK_STATES,
+    CA_OPEN_BLOCK,     // '{'
+    CA_CLOSE_BLOCK,    // '}'
+    CA_OPEN_IF,        // the ')' of a condition
+    CA_END_STATEMENT,  // ';'
+    CA_END_INPUT,      // the end of the input
+    CA_AFTER_THEN      // any token after the statement of an if
+};
+
+struct CheckTables
+{
+    ByteClass byteClass[256];
+    TokenType punctKind[256];
+    uint8_t transitions[CHECK_STATES][T_EOF + 1];
+};
+
+constexpr CheckTables buildCheckTables()
+{
+    CheckTables tables = {};
+    for (int c = 0; c < 256; c++)
+    {
+        tables.byteClass[c] = B_OTHER;
+        tables.punctKind[c] = T_EOF;
+    }
+    for (int c = 'a'; c <= 'z'; c++)
+        tables.byteClass[c] = tables.byteClass[c - 'a' + 'A'] = B_LETTER;
+    for (int c = '0'; c <= '9'; c++)
+        tables.byteClass[c] = B_DIGIT;
+    for (char c : {' ', '\t', '\n', '\v', '\f', '\r'})
+        tables.byteClass[static_cast<unsigned char>(c)] = B_SPACE;
+    const char punct[] = "=+-*/(){};>";
+    const TokenType kinds[] = {T_ASSIGN, T_PLUS, T_MINUS, T_MUL, T_DIV, T_LPAREN, T_RPAREN,
+                               T_LBRACE, T_RBRACE, T_SEMICOLON, T_GT};
+    for (int i = 0; punct[i]; i++)
+    {
+        tables.byteClass[static_cast<unsigned char>(punct[i])] = B_PUNCT;
+        tables.punctKind[static_cast<unsigned char>(punct[i])] = kinds[i];
+    }
+
+    for (int state = 0; state < CHECK_STATES; state++)
+        for (int kind = 0; kind <= T_EOF; kind++)
+            tables.transitions[state][kind] = CA_ERROR;
+    uint8_t(&t)[CHECK_STATES][T_EOF + 1] = tables.transitions;
+    t[CS_STATEMENT][T_INT] = CS_DECL_ID;
+    t[CS_STATEMENT][T_ID] = CS_ASSIGN_EQ;
+    t[CS_STATEMENT][T_IF] = CS_IF_LPAREN;
+    t[CS_STATEMENT][T_RETURN] = CS_OPERAND;
+    t[CS_STATEMENT][T_LBRACE] = CA_OPEN_BLOCK;
+    for (int kind = 0; kind <= T_EOF; kind++)
+        t[CS_BRANCH][kind] = t[CS_STATEMENT][kind];
+    t[CS_STATEMENT][T_RBRACE] = CA_CLOSE_BLOCK;
+    t[CS_STATEMENT][T_EOF] = CA_END_INPUT;
+    t[CS_DECL_ID][T_ID] = CS_DECL_SEMI;
+    t[CS_DECL_SEMI][T_SEMICOLON] = CA_END_STATEMENT;
+    t[CS_ASSIGN_EQ][T_ASSIGN] = CS_OPERAND;
+    t[CS_IF_LPAREN][T_LPAREN] = CS_COND_OPERAND;
+    t[CS_OPERAND][T_ID] = t[CS_OPERAND][T_NUM] = CS_OPERATOR;
+    t[CS_COND_OPERAND][T_ID] = t[CS_COND_OPERAND][T_NUM] = CS_COND_OPERATOR;
+    for (TokenType op : {T_PLUS, T_MINUS, T_MUL, T_DIV})
+    {
+        t[CS_OPERATOR][op] = CS_OPERAND;
+        t[CS_COND_OPERATOR][op] = CS_COND_OPERAND;
+    }
+    t[CS_OPERATOR][T_SEMICOLON] = CA_END_STATEMENT;
+    t[CS_COND_OPERATOR][T_RPAREN] = CA_OPEN_IF;
+    for (int kind = 0; kind <= T_EOF; kind++)
+        t[CS_AFTER_THEN][kind] = CA_AFTER_THEN;
+    return tables;
+}
+
+constexpr CheckTables CHECK_TABLES = buildCheckTables();
+constexpr const ByteClass *BYTE_CLASS = CHECK_TABLES.byteClass;
+constexpr const TokenType *PUNCT_KIND = CHECK_TABLES.punctKind;
+constexpr const uint8_t (*CHECK_TRANSITIONS)[T_EOF + 1] = CHECK_TABLES.transitions;
+
+/*
+    SyntaxChecker class:
+
+    Check-only mode: tells whether a source is a program Parser accepts and, if not, where the first
+    error is, without producing tokens. Lexing and recognition are fused into one pass over the bytes:
+    each token is classified in place (BYTE_CLASS, then a keyword compare for words) and fed straight
+    into CHECK_TRANSITIONS, so nothing is copied and nothing is allocated while checking.
+    - The only unbounded state is nesting: every open '{' and every if waiting for its statement is one
+      bit on a bit stack (1 = block, 0 = if). Its storage is kept across check() calls, so it only grows
+      when a source nests deeper than any before it.
+    - When the statement of an if is complete, the next token decides: 'else' starts the else statement,
+      anything else completes the if and is looked up again in the enclosing state.
+    - Whitespace, comments and longest-match rules are the Lexer's; long whitespace runs and comments are
+      skipped with the same SIMD kernels.
+    The line and column of an error are only worked out once an error is found.
+*/
+class SyntaxChecker
+{
+public:
+    struct Error
+    {
+        size_t line;
+        size_t column;
+        string_view token; // the offending token, empty at the end of input
+    };
+
+    SyntaxChecker()
+    {
+        nesting.reserve(64); // 4096 levels before the first growth
+    }
+
+    // Returns true if src is a valid program, otherwise false with error set. The byte after the end of
+    // src must be readable and '\0' (as it is after string::data()), so the scan needs no bounds checks.
+    bool check(string_view src, Error &error)
+    {
+        const char *begin = src.data();
+        const char *end = begin + src.size();
+        const char *p = begin;
+        uint8_t state = CS_STATEMENT;
+        depth = 0;
+
+        while (true)
+        {
+            // Whitespace and comments
+            while (true)
+            {
+                if (BYTE_CLASS[static_cast<unsigned char>(*p)] == B_SPACE)
+                {
+                    // Most runs are one separator; only longer ones (indentation) go to the kernel
+                    p++;
+                    if (BYTE_CLASS[static_cast<unsigned char>(*p)] == B_SPACE)
+                        p = begin + scan.skipSpace(begin, p + 1 - begin, src.size());
+                }
+                else if (*p == '/' && p[1] == '/')
+                {
+                    p = begin + scan.findNewline(begin, p + 2 - begin, src.size());
+                }
+                else if (*p == '/' && p[1] == '*')
+                {
+                    p = begin + scan.findCommentEnd(begin, p + 2 - begin, src.size());
+                    p = p < end ? p + 2 : end;
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            const char *start = p;
+            TokenType kind;
+            switch (BYTE_CLASS[static_cast<unsigned char>(*p)])
+            {
+            case B_PUNCT:
+                kind = PUNCT_KIND[static_cast<unsigned char>(*p++)];
+                break;
+            case B_LETTER:
+                while (BYTE_CLASS[static_cast<unsigned char>(*++p)] <= B_DIGIT)
+                    ;
+                kind = wordKind(start, p - start);
+                break;
+            case B_DIGIT:
+                while (BYTE_CLASS[static_cast<unsigned char>(*++p)] == B_DIGIT)
+                    ;
+                kind = T_NUM;
+                break;
+            default: // '\0' ends the input only at the end of src; any other byte is not a token
+                if (p != end)
+                    return fail(src, start, start + 1, error);
+                kind = T_EOF;
+                break;
+            }
+
+            uint8_t next = CHECK_TRANSITIONS[state][kind];
+            if (next < CHECK_STATES)
+            {
+                state = next;
+                continue;
+            }
+            next = act(next, kind);
+            if (next == CA_ERROR)
+                return fail(src, start, p, error);
+            if (next == CA_END_INPUT)
+                return true;
+            state = next;
+        }
+    }
+
+private:
+    vector<uint64_t> nesting; // bit stack of open blocks (1) and ifs (0)
+    size_t depth = 0;
+
+    static TokenType wordKind(const char *word, size_t length)
+    {
+        switch (length)
+        {
+        case 2:
+            return memcmp(word, "if", 2) == 0 ? T_IF : T_ID;
+        case 3:
+            return memcmp(word, "int", 3) == 0 ? T_INT : T_ID;
+        case 4:
+            return memcmp(word, "else", 4) == 0 ? T_ELSE : T_ID;
+        case 6:
+            return memcmp(word, "return", 6) == 0 ? T_RETURN : T_ID;
+        default:
+            return T_ID;
+        }
+    }
+
+    void push(bool block)
+    {
+        if (depth / 64 == nesting.size())
+            nesting.push_back(0);
+        uint64_t bit = uint64_t(1) << (depth % 64);
+        nesting[depth / 64] = block ? nesting[depth / 64] | bit : nesting[depth / 64] & ~bit;
+        depth++;
+    }
+
+    bool topIsBlock() const
+    {
+        return (nesting[(depth - 1) / 64] >> ((depth - 1) % 64)) & 1;
+    }
+
+    // A statement is complete; an if waiting for it decides on the next token.
+    uint8_t statementDone() const
+    {
+        return depth > 0 && !topIsBlock() ? CS_AFTER_THEN : CS_STATEMENT;
+    }
+
+    // Carries out an action from CHECK_TRANSITIONS; returns the next state, CA_ERROR or CA_END_INPUT.
+    uint8_t act(uint8_t action, TokenType kind)
+    {
+        while (true)
+        {
+            switch (action)
+            {
+            case CA_OPEN_BLOCK:
+                push(true);
+                return CS_STATEMENT;
+            case CA_CLOSE_BLOCK:
+                // Only reached in CS_STATEMENT, where the top of the stack can only be a block
+                if (depth == 0)
+                    return CA_ERROR;
+                depth--;
+                return statementDone();
+            case CA_OPEN_IF:
+                push(false);
+                return CS_BRANCH;
+            case CA_END_STATEMENT:
+                return statementDone();
+            case CA_END_INPUT:
+                return depth == 0 ? CA_END_INPUT : CA_ERROR;
+            case CA_AFTER_THEN:
+                depth--; // the if is done with its statement
+                if (kind == T_ELSE)
+                    return CS_BRANCH; // the else statement completes the if in its place
+                action = CHECK_TRANSITIONS[statementDone()][kind];
+                if (action < CHECK_STATES)
+                    return action;
+                break;
+            default:
+                return CA_ERROR;
+            }
+        }
+    }
+
+    static bool fail(string_view src, const char *start, const char *stop, Error &error)
+    {
+        size_t offset = start - src.data();
+        size_t lineStart = offset == 0 ? string_view::npos : src.rfind('\n', offset - 1);
+        error.line = 1 + count(src.begin(), src.begin() + offset, '\n');
+        error.column = offset - (lineStart == string_view::npos ? 0 : lineStart + 1) + 1;
+        error.token = string_view(start, stop - start);
+        return false;
+    }
+};
+
+/*
+    readAll reads file to its end into buffer, in blocks, so it works the same for regular files, pipes
+    and stdin, whose size is not known up front. buffer keeps its capacity from the previous file.
+    Returns false on a read error.
+*/
+bool readAll(FILE *file, string &buffer)
+{
+    size_t used = 0;
+    buffer.resize(buffer.capacity() > 0 ? buffer.capacity() : size_t(1) << 16);
+    while (true)
+    {
+        used += fread(&buffer[used], 1, buffer.size() - used, file);
+        if (used < buffer.size())
+            break; // end of file or an error; fread only returns short then
+        buffer.resize(buffer.size() * 2);
+    }
+    buffer.resize(used);
+    return !ferror(file);
+}
+
+/*
+    checkFiles runs SyntaxChecker over every file (compiler2 --check file...): it prints nothing for a
+    file that passes, "file:line:column: syntax error at 'token'" for one that fails, and the totals and
+    throughput on stderr. "-" checks stdin. A file that cannot be opened or read counts as failed.
+    One read buffer and one checker are reused for all files. Returns the exit status: 0 if every file passed.
+*/
+int checkFiles(int count, char *files[])
+{
+    SyntaxChecker checker;
+    string buffer;
+    size_t bytes = 0;
+    int failed = 0;
+    double seconds = 0;
+    for (int i = 0; i < count; i++)
+    {
+        bool isStdin = string(files[i]) == "-";
+        FILE *file = isStdin ? stdin : fopen(files[i], "rb");
+        if (!file)
+        {
+            cout << files[i] << ": cannot open" << endl;
+            failed++;
+            continue;
+        }
+        bool read = readAll(file, buffer);
+        if (!isStdin)
+            fclose(file);
+        if (!read)
+        {
+            cout << files[i] << ": cannot read" << endl;
+            failed++;
+            continue;
+        }
+
+        auto start = chrono::steady_clock::now();
+        SyntaxChecker::Error error;
+        bool ok = checker.check(buffer, error);
+        seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        bytes += buffer.size();
+        if (!ok)
+        {
+            failed++;
+            cout << files[i] << ":" << error.line << ":" << error.column << ": syntax error at '"
+                 << (error.token.empty() ? "end of input" : error.token) << "'" << endl;
+        }
+    }
+    cerr << count << " files, " << failed << " failed, " << bytes << " bytes checked in " << seconds << " s ("
+         << (seconds > 0 ? bytes / seconds / 1e9 : 0) << " GB/s)" << endl;
+    return failed ? 1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && string(argv[1]) == "--check")
+    {
+        return checkFiles(argc - 2, argv + 2);
+    }
+
     // Sample input with comments
     string input = R"(
         // This is a single line comment
@@ -0,0 +1,154 @@
+// Test for Lexer::tokenizeParallel: generates sources of several megabytes (above MIN_PARALLEL_CHUNK, so they
+// are really split) full of multi-line /* */ comments, some longer than a whole chunk, and // comments that
+// contain comment markers. For several thread counts it compares tokenizeParallel with tokenize() token by
+// token (kind, offset, id or value, line) and the interned names in id order. It also counts how many chunk
+// cuts fell inside a block comment and fails if none did, so the carried-over comment state is exercised.
+#include <random>
+
+#define main labMain
+#include "../compiler.cpp"
+#undef main
+
+struct Source
+{
+    string text;
+    vector<pair<size_t, size_t>> comments; // [start, end) of every block comment
+};
+
+static const char *const STATEMENTS[] = {
+    "int a = 1;",
+    "b = a * 3 - b / 2;",
+    "while (a < 10) { a = a + 1; }",
+    "if (a >= b) { c = a; } else { c = b; }",
+    "x1 = x1 + y22 - 7;",
+    "return c;",
+    "total = total + a * b;",
+};
+
+static const char *const COMMENT_LINES[] = {
+    " * a line inside a block comment",
+    " * looks like code a = b / c * d;",
+    " * // not a line comment in here",
+    " * /* not a nested comment either",
+    " ** stars and / slashes * / but no end",
+    "",
+};
+
+// Builds a source of about the given number of bytes; block comments are up to maxComment bytes long.
+static Source generate(mt19937 &rng, size_t bytes, size_t maxComment)
+{
+    Source source;
+    string &text = source.text;
+    auto pick = [&](size_t n) { return static_cast<size_t>(rng() % n); };
+    while (text.size() < bytes)
+    {
+        size_t choice = pick(10);
+        if (choice < 6)
+        {
+            text += STATEMENTS[pick(size(STATEMENTS))];
+        }
+        else if (choice < 8)
+        {
+            text += "// line comment with /* and */ in it\n";
+            continue;
+        }
+        else
+        {
+            size_t start = text.size();
+            size_t length = 2 + pick(maxComment);
+            text += pick(2) ? "/*" : "/**";
+            while (text.size() - start < length)
+            {
+                text += '\n';
+                text += COMMENT_LINES[pick(size(COMMENT_LINES))];
+            }
+            text += pick(2) ? " */" : "\n**/";
+            source.comments.push_back({start, text.size()});
+        }
+        text += pick(4) ? "\n" : "  ";
+    }
+    return source;
+}
+
+// The chunk starts tokenizeParallel picks for threadCount threads, computed the same way it does
+// (MIN_PARALLEL_CHUNK is 1 MB).
+static vector<size_t> cuts(const string &src, unsigned threadCount)
+{
+    size_t chunkCount = min<size_t>(threadCount, src.size() / (1 << 20));
+    vector<size_t> bounds{0};
+    for (size_t k = 1; k < chunkCount; k++)
+    {
+        size_t cut = src.find('\n', max(k * src.size() / chunkCount, bounds.back()));
+        if (cut == string::npos || cut + 1 >= src.size())
+            break;
+        bounds.push_back(cut + 1);
+    }
+    bounds.erase(bounds.begin());
+    return bounds;
+}
+
+// Each Lexer keeps its own copy of the source, so offsets are compared relative to the T_EOF token,
+// which sits at the end of the source.
+static size_t offset(const TokenBuffer &tokens, size_t i)
+{
+    return tokens.text(i).data() - tokens.text(tokens.size() - 1).data();
+}
+
+static bool sameTokens(const TokenBuffer &a, const TokenBuffer &b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (a.kind(i) != b.kind(i) || a.text(i) != b.text(i) || offset(a, i) != offset(b, i) ||
+            a.id(i) != b.id(i) || a.line(i) != b.line(i))
+            return false;
+    }
+    return true;
+}
+
+int main()
+{
+    mt19937 rng(471);
+    const unsigned THREAD_COUNTS[] = {1, 2, 3, 4, 7};
+    // size, longest block comment: the last source has comments longer than a whole chunk
+    const pair<size_t, size_t> SHAPES[] = {{3u << 20, 4096}, {5u << 20, 200000}, {8u << 20, 3u << 20}};
+    int failures = 0;
+    size_t checks = 0, cutsInComments = 0;
+    for (const auto &shape : SHAPES)
+    {
+        Source source = generate(rng, shape.first, shape.second);
+        StringInterner serialNames;
+        Lexer serialLexer(source.text, serialNames); // the tokens view its copy of the source
+        TokenBuffer serial = serialLexer.tokenize();
+        for (unsigned threads : THREAD_COUNTS)
+        {
+            StringInterner names;
+            Lexer lexer(source.text, names);
+            TokenBuffer parallel = lexer.tokenizeParallel(threads);
+            bool same = sameTokens(serial, parallel) && names.size() == serialNames.size();
+            for (uint32_t id = 0; same && id < names.size(); id++)
+                same = names.name(id) == serialNames.name(id);
+            if (!same)
+            {
+                cout << "FAIL: " << source.text.size() << " bytes, " << threads << " threads" << endl;
+                failures++;
+            }
+            checks++;
+            for (size_t cut : cuts(source.text, threads))
+            {
+                for (const auto &comment : source.comments)
+                    if (comment.first < cut && cut < comment.second)
+                        cutsInComments++;
+            }
+        }
+    }
+    if (cutsInComments == 0)
+    {
+        cout << "FAIL: no chunk cut fell inside a block comment" << endl;
+        failures++;
+    }
+    cout << checks << " sources x thread counts, " << cutsInComments << " cuts inside block comments, "
+         << failures << " failed" << endl;
+    return failures == 0 ? 0 : 1;
+}
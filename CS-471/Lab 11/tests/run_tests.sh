@@ -0,0 +1,10 @@
+#!/bin/sh
+# Tests for the Lab 11 interpreter's lexer: builds parallel_test.cpp, which checks tokenizeParallel against
+# tokenize() on multi-megabyte sources whose block comments cross the chunk boundaries.
+# Usage: sh run_tests.sh        (CXX picks the compiler, g++ by default)
+cd "$(dirname "$0")" || exit 1
+CXX=${CXX:-g++}
+work=$(mktemp -d) || exit 1
+trap 'rm -rf "$work"' EXIT
+$CXX -std=c++17 -O2 -pthread -o "$work/parallel_test" parallel_test.cpp || exit 1
+"$work/parallel_test"
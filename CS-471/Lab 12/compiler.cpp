@@ -175,7 +175,7 @@ public:
 class Parser
 {
 private:
-    vector<Token> tokens;
+    const vector<Token> &tokens; // borrowed, not copied: the caller keeps the vector alive while parsing
     size_t pos;
     SymbolTable &symbolTable;
 
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <cassert>
 #include <map>
 #include <stdexcept>
 
@@ -19,17 +20,60 @@ struct Token {
     int lineNumber;
 };
 
+// Token DFA generated by lexgen (Lab 14/lexgen.cpp) from TAC.tokens; the Lexer matches each token,
+// keywords included, with matchToken, one table lookup per byte. Regenerate with: lexgen TAC.tokens > TAC_dfa.h
+#include "TAC_dfa.h"
+
+/*
+    Lexer class:
+    The parser pulls tokens one at a time with next() and looks ahead with peek(k). Tokens that are
+    scanned but not consumed yet are kept in a small ring buffer, so the whole token list is never
+    built in memory. tokenize() is kept as a wrapper that collects every token into a vector.
+*/
 class Lexer {
 private:
     string src;
     size_t pos;
     int lineNumber;
 
+    static constexpr size_t LOOKAHEAD = 4; // ring buffer size, must be a power of two
+    static_assert((LOOKAHEAD & (LOOKAHEAD - 1)) == 0, "LOOKAHEAD must be a power of two");
+    Token ring[LOOKAHEAD];
+    size_t head = 0;  // slot of the oldest buffered token
+    size_t count = 0; // number of buffered tokens
+
 public:
     Lexer(const string &src) : src(src), pos(0), lineNumber(1) {}
 
+    // k must be below LOOKAHEAD: the ring holds that many tokens, and a deeper peek would overwrite
+    // buffered tokens that have not been consumed yet.
+    const Token &peek(size_t k = 0) {
+        assert(k < LOOKAHEAD);
+        while (count <= k) {
+            ring[(head + count) & (LOOKAHEAD - 1)] = scanToken();
+            count++;
+        }
+        return ring[(head + k) & (LOOKAHEAD - 1)];
+    }
+
+    Token next() {
+        Token token = peek();
+        head = (head + 1) & (LOOKAHEAD - 1);
+        count--;
+        return token;
+    }
+
     vector<Token> tokenize() {
         vector<Token> tokens;
+        do {
+            tokens.push_back(next());
+        } while (tokens.back().type != T_EOF);
+        return tokens;
+    }
+
+private:
+    // Scans one token starting at pos, skipping any whitespace in front of it.
+    Token scanToken() {
         while (pos < src.size()) {
             char current = src[pos];
 
@@ -42,55 +86,17 @@ public:
                 pos++;
                 continue;
             }
-            if (isdigit(current)) {
-                tokens.push_back(Token{T_NUM, consumeNumber(), lineNumber});
-                continue;
-            }
-            if (isalpha(current)) {
-                string word = consumeWord();
-                TokenType type = T_ID;
-
-                if (word == "int") type = T_INT;
-                else if (word == "if") type = T_IF;
-                else if (word == "else") type = T_ELSE;
-                else if (word == "return") type = T_RETURN;
-
-                tokens.push_back(Token{type, word, lineNumber});
-                continue;
-            }
-
-            switch (current) {
-                case '=': tokens.push_back(Token{T_ASSIGN, "=", lineNumber}); break;
-                case '+': tokens.push_back(Token{T_PLUS, "+", lineNumber}); break;
-                case '-': tokens.push_back(Token{T_MINUS, "-", lineNumber}); break;
-                case '*': tokens.push_back(Token{T_MUL, "*", lineNumber}); break;
-                case '/': tokens.push_back(Token{T_DIV, "/", lineNumber}); break;
-                case '(': tokens.push_back(Token{T_LPAREN, "(", lineNumber}); break;
-                case ')': tokens.push_back(Token{T_RPAREN, ")", lineNumber}); break;
-                case '{': tokens.push_back(Token{T_LBRACE, "{", lineNumber}); break;
-                case '}': tokens.push_back(Token{T_RBRACE, "}", lineNumber}); break;
-                case ';': tokens.push_back(Token{T_SEMICOLON, ";", lineNumber}); break;
-                case '>': tokens.push_back(Token{T_GT, ">", lineNumber}); break;
-                default:
-                    cout << "Unexpected character: " << current << " at line " << lineNumber << endl;
-                    exit(1);
+            size_t length;
+            int kind = matchToken(src.data() + pos, src.data() + src.size(), length);
+            if (kind < 0) {
+                cout << "Unexpected character: " << current << " at line " << lineNumber << endl;
+                exit(1);
             }
-            pos++;
+            Token token{static_cast<TokenType>(kind), src.substr(pos, length), lineNumber};
+            pos += length;
+            return token;
         }
-        tokens.push_back(Token{T_EOF, "", lineNumber});
-        return tokens;
-    }
-
-    string consumeNumber() {
-        size_t start = pos;
-        while (pos < src.size() && isdigit(src[pos])) pos++;
-        return src.substr(start, pos - start);
-    }
-
-    string consumeWord() {
-        size_t start = pos;
-        while (pos < src.size() && isalnum(src[pos])) pos++;
-        return src.substr(start, pos - start);
+        return Token{T_EOF, "", lineNumber};
     }
 };
 
@@ -199,35 +205,34 @@ public:
 class Parser {
 public:
     //Constructor
-    Parser(const vector<Token> &tokens, SymbolTable &symTable, IntermediateCodeGnerator &icg)
-        : tokens(tokens), pos(0), symTable(symTable), icg(icg) {}
+    Parser(Lexer &lexer, SymbolTable &symTable, IntermediateCodeGnerator &icg)
+        : lexer(lexer), symTable(symTable), icg(icg) {}
         //here the private member of this class are being initalized with the arguments passed to this constructor
 
     void parseProgram() {
-        while (tokens[pos].type != T_EOF) {
+        while (lexer.peek().type != T_EOF) {
             parseStatement();
         }
     }
 
 private:
-    vector<Token> tokens;
-    size_t pos;
+    Lexer &lexer; // tokens are pulled from the lexer as the parser needs them
     SymbolTable &symTable;
     IntermediateCodeGnerator &icg;
 
     void parseStatement() {
-        if (tokens[pos].type == T_INT) {
+        if (lexer.peek().type == T_INT) {
             parseDeclaration();
-        } else if (tokens[pos].type == T_ID) {
+        } else if (lexer.peek().type == T_ID) {
             parseAssignment();
-        } else if (tokens[pos].type == T_IF) {
+        } else if (lexer.peek().type == T_IF) {
             parseIfStatement();
-        } else if (tokens[pos].type == T_RETURN) {
+        } else if (lexer.peek().type == T_RETURN) {
             parseReturnStatement();
-        } else if (tokens[pos].type == T_LBRACE) {
+        } else if (lexer.peek().type == T_LBRACE) {
             parseBlock();
         } else {
-            cout << "Syntax error: unexpected token '" << tokens[pos].value << "' at line " << tokens[pos].lineNumber << endl;
+            cout << "Syntax error: unexpected token '" << lexer.peek().value << "' at line " << lexer.peek().lineNumber << endl;
             exit(1);
         }
     }
@@ -288,7 +293,7 @@ private:
 
         parseStatement();
 
-        if (tokens[pos].type == T_ELSE) {            // If an `else` part exists, handle it.
+        if (lexer.peek().type == T_ELSE) {            // If an `else` part exists, handle it.
             icg.addInstruction("goto L3");
             icg.addInstruction("L2:");
             expect(T_ELSE);
@@ -319,7 +324,7 @@ private:
     */
     void parseBlock() {
         expect(T_LBRACE);           // Expect and consume the opening brace `{`.
-        while (tokens[pos].type != T_RBRACE && tokens[pos].type != T_EOF) {
+        while (lexer.peek().type != T_RBRACE && lexer.peek().type != T_EOF) {
             parseStatement();       // Parse the statements inside the block.
         }
         expect(T_RBRACE);
@@ -333,15 +338,15 @@ private:
     */
     string parseExpression() {
         string term = parseTerm();
-        while (tokens[pos].type == T_PLUS || tokens[pos].type == T_MINUS) {
-            TokenType op = tokens[pos++].type;
+        while (lexer.peek().type == T_PLUS || lexer.peek().type == T_MINUS) {
+            TokenType op = lexer.next().type;
             string nextTerm = parseTerm();    // Parse the next term in the expression.
             string temp = icg.newTemp();     // Generate a temporary variable for the result
             icg.addInstruction(temp + " = " + term + (op == T_PLUS ? " + " : " - ") + nextTerm); // Intermediate code for operation
             term = temp;
         }
-        if (tokens[pos].type == T_GT) {
-            pos++;
+        if (lexer.peek().type == T_GT) {
+            lexer.next();
             string nextExpr = parseExpression();    // Parse the next expression for the comparison.
             string temp = icg.newTemp();             // Generate a temporary variable for the result.
             icg.addInstruction(temp + " = " + term + " > " + nextExpr); // Intermediate code for the comparison.
@@ -358,8 +363,8 @@ private:
     */
     string parseTerm() {
         string factor = parseFactor();
-        while (tokens[pos].type == T_MUL || tokens[pos].type == T_DIV) {
-            TokenType op = tokens[pos++].type;
+        while (lexer.peek().type == T_MUL || lexer.peek().type == T_DIV) {
+            TokenType op = lexer.next().type;
             string nextFactor = parseFactor();
             string temp = icg.newTemp(); // Generate a temporary variable for the result.
             icg.addInstruction(temp + " = " + factor + (op == T_MUL ? " * " : " / ") + nextFactor);  // Intermediate code for operation.
@@ -376,17 +381,17 @@ private:
         (5 + 3);    --> This will return the sub-expression "5 + 3".
     */
     string parseFactor() {
-        if (tokens[pos].type == T_NUM) {
-            return tokens[pos++].value;
-        } else if (tokens[pos].type == T_ID) {
-            return tokens[pos++].value;
-        } else if (tokens[pos].type == T_LPAREN) {
+        if (lexer.peek().type == T_NUM) {
+            return lexer.next().value;
+        } else if (lexer.peek().type == T_ID) {
+            return lexer.next().value;
+        } else if (lexer.peek().type == T_LPAREN) {
             expect(T_LPAREN);
             string expr = parseExpression();
             expect(T_RPAREN);
             return expr;
         } else {
-            cout << "Syntax error: unexpected token '" << tokens[pos].value << "' at line " << tokens[pos].lineNumber << endl;
+            cout << "Syntax error: unexpected token '" << lexer.peek().value << "' at line " << lexer.peek().lineNumber << endl;
             exit(1);
         }
     }
@@ -397,24 +402,24 @@ private:
         and the program exits. If the token type matches, it advances the position to the next token.
     */
     void expect(TokenType type) {
-    if (tokens[pos].type != type) {
-        cout << "Syntax error: expected '" << type << "' at line " << tokens[pos].lineNumber << endl;
+    if (lexer.peek().type != type) {
+        cout << "Syntax error: expected '" << type << "' at line " << lexer.peek().lineNumber << endl;
         exit(1);
     }
-    pos++;
+    lexer.next();
 }
         /* 
         Explanation:
         - The `expect` function ensures that the parser encounters the correct tokens in the expected order. 
         - It's mainly used for non-value-based tokens, such as keywords, operators, and delimiters (e.g., semicolons).
         - If the parser encounters an unexpected token, it halts the process by printing an error message, indicating where the error occurred (line number) and what was expected.
-        - The `pos++` advances to the next token after confirming the expected token is present.
+        - The `lexer.next()` call advances to the next token after confirming the expected token is present.
 
         Use Case:
         - This function is helpful when checking for the correct syntax or structure in a language's grammar, ensuring the parser processes the tokens in the correct order.
         */
     string expectAndReturnValue(TokenType type) {
-        string value = tokens[pos].value;
+        string value = lexer.peek().value;
         expect(type);
         return value;
     }
@@ -443,11 +448,10 @@ int main() {
     }
     )";
     Lexer lexer(src);
-    vector<Token> tokens = lexer.tokenize();
 
     SymbolTable symTable;
     IntermediateCodeGnerator icg;
-    Parser parser(tokens, symTable, icg);
+    Parser parser(lexer, symTable, icg);
 
     parser.parseProgram();
     icg.printInstructions();
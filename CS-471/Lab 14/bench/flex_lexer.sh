@@ -0,0 +1,42 @@
+#!/bin/sh
+# Compares cc.cpp's hand-written scanner with the flex scanner generated from cc.l: builds lexer.cpp
+# both ways and runs each on a generated statement mix of SIZE_MB megabytes, after checking with
+# tests/tokens.cpp that both scanners produce the same tokens for it. Needs flex (FLEX picks the
+# program); without it only the hand-written scanner is measured.
+# Usage: sh flex_lexer.sh [SIZE_MB]        (50 by default; CXX picks the compiler, g++ by default)
+cd "$(dirname "$0")" || exit 1
+SIZE_MB=${1:-50}
+CXX=${CXX:-g++}
+FLEX=${FLEX:-flex}
+work=$(mktemp -d) || exit 1
+trap 'rm -rf "$work"' EXIT
+$CXX -std=c++17 -O2 -o "$work/hand" lexer.cpp || exit 1
+
+awk -v bytes=$((SIZE_MB * 1024 * 1024)) 'BEGIN {
+    print "int x;"; print "int total;"
+    body = "total = total + x * 42; /* running sum */\nif (total > 1000) {\n    total = total - 1000;\n}\nwhile (x > 0) { x = x - 1; }"
+    n = int(bytes / (length(body) + 1))
+    for (i = 0; i < n; i++) print body
+}' > "$work/input.c"
+echo "input: $(wc -c < "$work/input.c") bytes"
+
+printf '%-6s ' "hand"
+"$work/hand" "$work/input.c" || exit 1
+if ! command -v "$FLEX" > /dev/null; then
+    echo "flex    not found, skipped (install flex or set FLEX)"
+    exit 0
+fi
+"$FLEX" -o "$work/cc.yy.c" ../cc.l || exit 1
+$CXX -std=c++17 -O2 -DCC_FLEX_LEXER -I"$work" -o "$work/flex" lexer.cpp || exit 1
+$CXX -std=c++17 -O2 -o "$work/tokens_hand" ../tests/tokens.cpp || exit 1
+$CXX -std=c++17 -O2 -DCC_FLEX_LEXER -I"$work" -o "$work/tokens_flex" ../tests/tokens.cpp || exit 1
+"$work/tokens_hand" "$work/input.c" > "$work/hand.tokens"
+"$work/tokens_flex" "$work/input.c" > "$work/flex.tokens"
+if ! cmp -s "$work/hand.tokens" "$work/flex.tokens"; then
+    echo "flex    token listing differs from the hand-written scanner's:"
+    diff "$work/hand.tokens" "$work/flex.tokens" | head -20
+    exit 1
+fi
+echo "flex    same $(wc -l < "$work/flex.tokens") tokens as the hand-written scanner"
+printf '%-6s ' "flex"
+"$work/flex" "$work/input.c" || exit 1
@@ -0,0 +1,92 @@
+// Keyword classification benchmark: includes the lexer source named by LAB_SOURCE (cc.cpp or tip.cpp),
+// builds an identifier-dense corpus of WORDS words (90% identifiers, many of them sharing length, first
+// and last character with a keyword so they land in a keyword's slot, 10% keywords) and times
+// keywordOrIdentifier against a string compare per keyword, the if/else chain it replaced. Both must
+// classify every word the same way.
+#include <chrono>
+#include <random>
+
+#define main labMain
+#include LAB_SOURCE
+#undef main
+
+// The classification the lexers did before the perfect hash: compare the word with each keyword in turn
+static TokenType compareEachKeyword(string_view word)
+{
+    for (const Keyword &keyword : KEYWORDS)
+    {
+        if (word == keyword.text)
+            return keyword.type;
+    }
+    return T_ID;
+}
+
+// Runs classify over every word and returns the time per word in ns; checksum keeps the loop alive
+template <typename Classify>
+static double timePerWord(const vector<string> &words, Classify classify, long &checksum)
+{
+    auto start = chrono::steady_clock::now();
+    for (const string &word : words)
+        checksum += classify(word);
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / words.size();
+}
+
+int main(int argc, char *argv[])
+{
+    size_t count = argc > 1 ? stoul(argv[1]) : 2000000;
+    mt19937 random(471);
+
+    // Identifiers: for each keyword a few lookalikes (same length, first and last character) and
+    // prefixes/extensions of it, plus ordinary names of assorted lengths
+    vector<string> identifiers;
+    for (const Keyword &keyword : KEYWORDS)
+    {
+        string text(keyword.text);
+        for (char middle = 'a'; middle <= 'z' && text.size() > 2; middle += 5)
+        {
+            string lookalike = text;
+            lookalike[1] = middle;
+            if (lookalike != text)
+                identifiers.push_back(lookalike);
+        }
+        identifiers.push_back(text.substr(0, text.size() - 1) + "x");
+        identifiers.push_back(text + "s");
+    }
+    for (int i = 0; i < 200; i++)
+    {
+        string name(1 + random() % 12, 'a');
+        for (char &ch : name)
+            ch = 'a' + random() % 26;
+        identifiers.push_back(name);
+    }
+
+    vector<string> words;
+    words.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        if (random() % 10 == 0)
+            words.emplace_back(KEYWORDS[random() % size(KEYWORDS)].text);
+        else
+            words.push_back(identifiers[random() % identifiers.size()]);
+    }
+
+    for (const string &word : words)
+    {
+        if (keywordOrIdentifier(word) != compareEachKeyword(word))
+        {
+            cout << "Mismatch on \"" << word << "\"" << endl;
+            return 1;
+        }
+    }
+
+    long checksum = 0;
+    double best[2] = {1e30, 1e30};
+    for (int round = 0; round < 3; round++)
+    {
+        best[0] = min(best[0], timePerWord(words, compareEachKeyword, checksum));
+        best[1] = min(best[1], timePerWord(words, keywordOrIdentifier, checksum));
+    }
+    cout << words.size() << " words, " << identifiers.size() << " distinct identifiers, best of 3: compare each keyword "
+         << best[0] << " ns/word, perfect hash " << best[1] << " ns/word (checksum " << checksum << ")" << endl;
+    return 0;
+}
@@ -0,0 +1,15 @@
+#!/bin/sh
+# Keyword classification benchmark for cc.cpp and tip.cpp: builds keywords.cpp against each lexer and
+# runs it on an identifier-dense corpus of WORDS words.
+# Usage: sh keywords.sh [WORDS]        (2000000 by default; CXX picks the compiler, g++ by default)
+cd "$(dirname "$0")" || exit 1
+WORDS=${1:-2000000}
+CXX=${CXX:-g++}
+work=$(mktemp -d) || exit 1
+trap 'rm -rf "$work"' EXIT
+
+for lexer in cc tip; do
+    $CXX -std=c++17 -O2 -w -DLAB_SOURCE="\"../$lexer.cpp\"" -o "$work/keywords" keywords.cpp || exit 1
+    printf '%-4s ' "$lexer"
+    "$work/keywords" "$WORDS" || exit 1
+done
@@ -0,0 +1,35 @@
+#!/bin/sh
+# Compares LalrParser with the recursive-descent Parser in cc.cpp: builds parse.cpp both ways and runs
+# each on three generated inputs, a statement mix, an expression-heavy program and DEPTH nested loops,
+# printing lex+parse time, throughput and peak RSS.
+# Usage: sh lalr.sh [SIZE_MB [DEPTH]]        (25 and 1000000 by default; CXX picks the compiler, g++ by default)
+cd "$(dirname "$0")" || exit 1
+SIZE_MB=${1:-25}
+DEPTH=${2:-1000000}
+CXX=${CXX:-g++}
+work=$(mktemp -d) || exit 1
+trap 'rm -rf "$work"' EXIT
+$CXX -std=c++17 -O2 -o "$work/rd" parse.cpp || exit 1
+$CXX -std=c++17 -O2 -DCC_LALR_PARSER -o "$work/lalr" parse.cpp || exit 1
+
+bytes=$((SIZE_MB * 1024 * 1024))
+awk -v bytes="$bytes" 'BEGIN {
+    print "int x;"; print "int y;"
+    body = "x = x + y * 3;\nif (x > y) {\n    y = x - 1;\n} else {\n    y = y + 1;\n}\nwhile (y > 0) { y = y - 1; }\nfor (x = 0; x < 10; x = (x + 1)) { y = y + x; }"
+    n = int(bytes / (length(body) + 1))
+    for (i = 0; i < n; i++) print body
+}' > "$work/statements.c"
+awk -v bytes="$bytes" 'BEGIN {
+    print "int x;"; print "int y;"
+    body = "x = ((x + 1) * (y - 2) + x / 3 - (y * (x + y) - 7)) * 2 + (x - (y - (x - 1)));"
+    n = int(bytes / (length(body) + 1))
+    for (i = 0; i < n; i++) print body
+}' > "$work/expressions.c"
+awk -v n="$DEPTH" 'BEGIN { print "int x;"; for (i = 0; i < n; i++) print "while (x > 0) {"; print "x = 1;"; for (i = 0; i < n; i++) printf "} "; print "" }' > "$work/nested.c"
+
+for input in statements expressions nested; do
+    for parser in rd lalr; do
+        printf '%-12s %-5s ' "$input" "$parser"
+        "$work/$parser" "$work/$input.c" || exit 1
+    done
+done
@@ -0,0 +1,51 @@
+// Parser benchmark: includes cc.cpp, then lexes and parses the file given as the first argument into the
+// arena AST (no code generation) and prints the time, the throughput and the peak RSS. Built with
+// -DCC_LALR_PARSER it measures LalrParser, otherwise the recursive-descent Parser.
+#include <sys/resource.h>
+#include <chrono>
+#include <cstdio>
+
+#define main ccMain
+#include "../cc.cpp"
+#undef main
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "Usage: " << argv[0] << " FILE" << endl;
+        return 1;
+    }
+    ifstream file(argv[1]);
+    if (!file)
+    {
+        cerr << "Cannot open " << argv[1] << endl;
+        return 1;
+    }
+    stringstream contents;
+    contents << file.rdbuf();
+    string src = contents.str();
+
+    auto start = chrono::steady_clock::now();
+    StringInterner names;
+    Lexer lexer(src, names);
+    SymbolTable symTable(names);
+    Arena arena;
+#ifdef CC_LALR_PARSER
+    LalrParser parser(lexer, symTable, arena);
+#else
+    Parser parser(lexer, symTable, arena);
+#endif
+    BlockStmt *program = parser.parseProgram();
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    size_t statements = 0;
+    for (Stmt *statement = program->first; statement; statement = statement->next)
+        statements++;
+
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    printf("%zu top-level statements, %.0f ms, %.1f MB/s, peak RSS %ld MB\n", statements, ms,
+           src.size() / ms / 1e3, usage.ru_maxrss / 1024);
+    return 0;
+}
@@ -0,0 +1,59 @@
+// Re-lexing latency benchmark: includes cc.cpp, lexes a random source of each size with
+// tokenizeForEditing, then types into it: the cursor jumps to a random place, and EDITS single
+// characters are typed there, some of them '!' on its own, which is an unexpected character until the
+// '=' after it is typed. Prints the full lex time, the mean relex time of a keystroke next to the previous
+// one, and of the first keystroke after a jump to a new place. Only relex is timed; changing the
+// std::string itself is the editor's business.
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+#define main ccMain
+#include "../cc.cpp"
+#undef main
+
+int main(int argc, char *argv[])
+{
+    size_t edits = argc > 1 ? stoul(argv[1]) : 2000;
+    mt19937 random(11);
+    const char *pieces[] = {" ", "\n", "x", "12", "int", "for", "=", ";", "(", ")", "{", "}", "+", "ab1", "7", "if"};
+    const char typed[] = "int q;\nq = q + 1;\nif (q != 2) { q = 3; }\n";
+
+    for (size_t megabytes : {1, 8, 32})
+    {
+        string text;
+        while (text.size() < megabytes << 20)
+            text += pieces[random() % size(pieces)];
+        StringInterner names;
+        Lexer lexer(text, names);
+        auto start = chrono::steady_clock::now();
+        EditableTokens tokens = lexer.tokenizeForEditing();
+        double fullMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        double typingMs = 0, jumpMs = 0;
+        size_t cursor = 0, jumps = 0;
+        for (size_t i = 0; i < edits; i++)
+        {
+            if (i % 100 == 0)
+                cursor = random() % text.size();
+            char ch = typed[i % (sizeof(typed) - 1)];
+            text.insert(cursor, 1, ch);
+            start = chrono::steady_clock::now();
+            lexer.relex(tokens, text, TextEdit{cursor, 0, 1});
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            if (i % 100 == 0)
+            {
+                jumpMs += ms;
+                jumps++;
+            }
+            else
+            {
+                typingMs += ms;
+            }
+            cursor++;
+        }
+        printf("%3zu MB, %9zu tokens: full lex %6.1f ms, relex %.4f ms per keystroke, %.3f ms after a jump\n",
+               megabytes, tokens.size(), fullMs, typingMs / (edits - jumps), jumpMs / jumps);
+    }
+    return 0;
+}
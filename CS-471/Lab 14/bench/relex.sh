@@ -0,0 +1,11 @@
+#!/bin/sh
+# Re-lexing latency benchmark for cc.cpp: builds relex.cpp and types EDITS keystrokes into random
+# sources of 1, 8 and 32 MB, printing the relex time per keystroke (and after a
+# cursor jump) next to a full lex.
+# Usage: sh relex.sh [EDITS]        (2000 by default; CXX picks the compiler, g++ by default)
+cd "$(dirname "$0")" || exit 1
+CXX=${CXX:-g++}
+work=$(mktemp -d) || exit 1
+trap 'rm -rf "$work"' EXIT
+$CXX -std=c++17 -O2 -o "$work/relex" relex.cpp || exit 1
+"$work/relex" ${1:+"$1"}
@@ -0,0 +1,93 @@
+// Scope benchmark: includes cc.cpp and measures its SymbolTable against a stack of per-scope maps, the
+// textbook layout where a lookup searches from the innermost scope outwards. Each of DEPTH scopes
+// declares two variables, one of them shadowing a global; the lookups alternate between that global
+// and one that is never shadowed, so the map stack has to search every scope for the latter.
+#include <chrono>
+#include <cstdio>
+#include <unordered_map>
+
+#define main ccMain
+#include "../cc.cpp"
+#undef main
+
+// One hash map per scope; lookups search from the innermost scope outwards
+class MapStack
+{
+public:
+    void enterScope()
+    {
+        scopes.emplace_back();
+    }
+
+    void exitScope()
+    {
+        scopes.pop_back();
+    }
+
+    void declareVariable(uint32_t id, DataType type)
+    {
+        if (!scopes.back().emplace(id, type).second)
+        {
+            throw runtime_error("already declared");
+        }
+    }
+
+    DataType getVariableType(uint32_t id) const
+    {
+        for (size_t i = scopes.size(); i-- > 0;)
+        {
+            auto found = scopes[i].find(id);
+            if (found != scopes[i].end())
+                return found->second;
+        }
+        throw runtime_error("not declared");
+    }
+
+private:
+    vector<unordered_map<uint32_t, DataType>> scopes{1};
+};
+
+// Nanoseconds from start to end, divided by count
+static double nsEach(chrono::steady_clock::time_point start, chrono::steady_clock::time_point end, size_t count)
+{
+    return chrono::duration<double, nano>(end - start).count() / count;
+}
+
+template <typename Table>
+static void run(const char *name, Table &table, size_t depth, size_t lookups)
+{
+    auto start = chrono::steady_clock::now();
+    table.declareVariable(0, TYPE_INT); // never shadowed
+    table.declareVariable(1, TYPE_INT); // shadowed in every scope
+    for (size_t level = 0; level < depth; level++)
+    {
+        table.enterScope();
+        table.declareVariable(1, TYPE_INT);
+        table.declareVariable(static_cast<uint32_t>(2 + level), TYPE_INT);
+    }
+    auto declared = chrono::steady_clock::now();
+    size_t checksum = 0;
+    for (size_t i = 0; i < lookups; i++)
+        checksum += table.getVariableType(i & 1) + 1; // + 1 since TYPE_INT is 0
+    auto looked = chrono::steady_clock::now();
+    for (size_t level = 0; level < depth; level++)
+        table.exitScope();
+    auto exited = chrono::steady_clock::now();
+
+    printf("%-9s depth %8zu: enter + 2 declarations %6.1f ns/scope, lookup %10.1f ns, exit %5.1f ns/scope (%zu)\n",
+           name, depth, nsEach(start, declared, depth), nsEach(declared, looked, lookups),
+           nsEach(looked, exited, depth), checksum);
+}
+
+int main()
+{
+    StringInterner names; // no names are interned; they are only needed for error messages
+    for (size_t depth : {1000, 100000, 1000000})
+    {
+        SymbolTable scoped(names);
+        run("scoped", scoped, depth, 2000000);
+        MapStack maps;
+        run("map-stack", maps, depth, depth >= 100000 ? 200 : 20000);
+    }
+    return 0;
+}
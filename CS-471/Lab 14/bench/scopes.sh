@@ -0,0 +1,19 @@
+#!/bin/sh
+# Scope benchmark for cc.cpp: runs scopes.cpp (SymbolTable against a stack of per-scope maps at depths
+# up to 1,000,000), then lexes and parses DEPTH nested blocks that each shadow x with both parsers.
+# Usage: sh scopes.sh [DEPTH]        (1000000 by default; CXX picks the compiler, g++ by default)
+cd "$(dirname "$0")" || exit 1
+DEPTH=${1:-1000000}
+CXX=${CXX:-g++}
+work=$(mktemp -d) || exit 1
+trap 'rm -rf "$work"' EXIT
+$CXX -std=c++17 -O2 -o "$work/scopes" scopes.cpp || exit 1
+$CXX -std=c++17 -O2 -o "$work/rd" parse.cpp || exit 1
+$CXX -std=c++17 -O2 -DCC_LALR_PARSER -o "$work/lalr" parse.cpp || exit 1
+
+"$work/scopes" || exit 1
+awk -v n="$DEPTH" 'BEGIN { print "int x;"; for (i = 0; i < n; i++) print "{ int x; x = 1;"; for (i = 0; i < n; i++) printf "} "; print "" }' > "$work/shadowing.c"
+for parser in rd lalr; do
+    printf 'shadowing blocks %-5s ' "$parser"
+    "$work/$parser" "$work/shadowing.c" || exit 1
+done
@@ -0,0 +1,27 @@
+#!/bin/sh
+# Streaming benchmark for the pull lexers: generates a statement mix of SIZE_MB megabytes that both
+# cc.cpp and tip.cpp accept, compiles it with each of them (TAC and assembly go to /dev/null) and
+# prints the wall time and peak RSS. With tokens pulled one at a time the peak stays near the size of
+# the source plus the emitted code rather than growing with a token vector.
+# Usage: sh stream.sh [SIZE_MB]        (100 by default; CXX picks the compiler, g++ by default)
+cd "$(dirname "$0")" || exit 1
+SIZE_MB=${1:-100}
+CXX=${CXX:-g++}
+work=$(mktemp -d) || exit 1
+trap 'rm -rf "$work"' EXIT
+$CXX -std=c++17 -O2 -o "$work/measure" ../../bench/measure.cpp || exit 1
+$CXX -std=c++17 -O2 -o "$work/cc" ../cc.cpp || exit 1
+$CXX -std=c++17 -O2 -o "$work/tip" ../tip.cpp || exit 1
+
+awk -v bytes=$((SIZE_MB * 1024 * 1024)) 'BEGIN {
+    print "int x;"; print "int y;"; print "x = 10;"
+    body = "x = x + y * 3;\nif (x > y) {\n    y = x - 1;\n}"
+    n = int(bytes / (length(body) + 1))
+    for (i = 0; i < n; i++) print body
+}' > "$work/input.c"
+echo "input: $(wc -c < "$work/input.c") bytes"
+
+for compiler in cc tip; do
+    printf '%-4s ' "$compiler"
+    "$work/measure" "$work/$compiler" "$work/input.c" 2>&1 > /dev/null || exit 1
+done
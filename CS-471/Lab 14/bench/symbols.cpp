@@ -0,0 +1,85 @@
+// Symbol table benchmark: includes cc.cpp, declares COUNT distinct variables (1,000,000 by default) and
+// looks up 4 x COUNT random ones, in its SymbolTable and in a map<string, string> from name to type
+// name, the table the lab started from (find, then operator[], the type returned by value).
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+#define main ccMain
+#include "../cc.cpp"
+#undef main
+
+class StringMapTable
+{
+public:
+    void declareVariable(const string &name, const string &type)
+    {
+        if (symbolTable.find(name) != symbolTable.end())
+        {
+            throw runtime_error("already declared");
+        }
+        symbolTable[name] = type;
+    }
+
+    string getVariableType(const string &name)
+    {
+        if (symbolTable.find(name) == symbolTable.end())
+        {
+            throw runtime_error("not declared");
+        }
+        return symbolTable[name];
+    }
+
+private:
+    map<string, string> symbolTable;
+};
+
+// Nanoseconds from start to end, divided by count
+static double nsEach(chrono::steady_clock::time_point start, chrono::steady_clock::time_point end, size_t count)
+{
+    return chrono::duration<double, nano>(end - start).count() / count;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t count = argc > 1 ? stoul(argv[1]) : 1000000;
+    StringInterner names;
+    vector<string> text(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        text[i] = "var" + to_string(i);
+        names.intern(text[i]);
+    }
+    vector<uint32_t> lookups(4 * size_t(count));
+    mt19937 random(471);
+    for (uint32_t &id : lookups)
+        id = random() % count;
+
+    size_t checksum = 0;
+    {
+        auto start = chrono::steady_clock::now();
+        SymbolTable table(names);
+        for (uint32_t id = 0; id < count; id++)
+            table.declareVariable(id, TYPE_INT);
+        auto declared = chrono::steady_clock::now();
+        for (uint32_t id : lookups)
+            checksum += table.getVariableType(id) + 1;
+        auto looked = chrono::steady_clock::now();
+        printf("SymbolTable (flat, by id)  declare %7.1f ns, lookup %7.1f ns\n", nsEach(start, declared, count),
+               nsEach(declared, looked, lookups.size()));
+    }
+    {
+        auto start = chrono::steady_clock::now();
+        StringMapTable table;
+        for (uint32_t id = 0; id < count; id++)
+            table.declareVariable(text[id], "int");
+        auto declared = chrono::steady_clock::now();
+        for (uint32_t id : lookups)
+            checksum += table.getVariableType(text[id]).size();
+        auto looked = chrono::steady_clock::now();
+        printf("map<string, string>        declare %7.1f ns, lookup %7.1f ns\n", nsEach(start, declared, count),
+               nsEach(declared, looked, lookups.size()));
+    }
+    printf("(checksum %zu)\n", checksum);
+    return 0;
+}
@@ -0,0 +1,16 @@
+#!/bin/sh
+# Symbol table benchmark for cc.cpp: runs symbols.cpp (SymbolTable against a map<string, string> with
+# COUNT variables), then lexes and parses a program that declares COUNT variables and assigns each one.
+# Usage: sh symbols.sh [COUNT]        (1000000 by default; CXX picks the compiler, g++ by default)
+cd "$(dirname "$0")" || exit 1
+COUNT=${1:-1000000}
+CXX=${CXX:-g++}
+work=$(mktemp -d) || exit 1
+trap 'rm -rf "$work"' EXIT
+$CXX -std=c++17 -O2 -o "$work/symbols" symbols.cpp || exit 1
+$CXX -std=c++17 -O2 -o "$work/rd" parse.cpp || exit 1
+
+"$work/symbols" "$COUNT" || exit 1
+awk -v n="$COUNT" 'BEGIN { for (i = 0; i < n; i++) print "int var" i ";"; for (i = 0; i < n; i++) print "var" i " = var" (i * 7919 % n) " + 1;" }' > "$work/variables.c"
+printf '%s variables: ' "$COUNT"
+"$work/rd" "$work/variables.c" || exit 1
@@ -3,9 +3,21 @@
 #include <algorithm>
 #include <unordered_map>
 #include <string>
+#include <cassert>
+#include <string_view>
+#include <deque>
+#include <cstdint>
 #include <map>
 #include <sstream>
+#include <fstream>
 #include <stdexcept>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -30,556 +42,1813 @@ enum TokenType
     T_RBRACE,
     T_SEMICOLON,
     T_GT,
+    T_LT,
+    T_EQ,
+    T_NEQ,
+    T_LTE,
+    T_GTE,
     T_EOF
 };
 
+/*
+    Token:
+    - value is a view into the source buffer handed to the Lexer, so no lexeme is copied onto the heap.
+    - The source buffer must therefore outlive every Token produced from it.
+    - id is the interned identifier id for T_ID tokens (see StringInterner), 0 for every other token.
+    - offset is where the token starts in the source; Lexer::relex uses it to line old tokens up with an edit.
+*/
 struct Token
 {
     TokenType type;
-    string value;
+    string_view value;
     int lineNumber;
+    uint32_t id = 0;
+    size_t offset = 0;
+};
+
+/*
+    TextEdit describes one change to a source buffer: the bytes [offset, offset + removed) of the old
+    source were replaced by inserted bytes, which now occupy [offset, offset + inserted) of the new source.
+*/
+struct TextEdit
+{
+    size_t offset;
+    size_t removed;
+    size_t inserted;
+};
+
+// An unexpected character that the Lexer skipped while lexing for an editor (see EditableTokens).
+struct LexError
+{
+    size_t offset;
+    int lineNumber;
+    char character;
+};
+
+/*
+    EditableTokens class:
+
+    The tokens of a source that an editor keeps changing, kept up to date by Lexer::relex. It holds what
+    tokenize() would return, laid out so that an edit never visits the tokens it does not change:
+    - The tokens are cut into blocks of about BLOCK_TOKENS. Every block covers a byte range of the source,
+      and its tokens store their offset and line number relative to the start of that range.
+    - Where a block starts is the sum of the sizes (bytes, lines) of the blocks in front of it, which a
+      Fenwick tree over the blocks gives in O(log blocks). So when an edit changes the size of one block,
+      the blocks behind it move without being touched, and finding the i-th token is O(log blocks) too.
+    - relex rebuilds only the blocks that hold re-scanned tokens. If the number of blocks changes (a block
+      grew past twice BLOCK_TOKENS and is split, or the re-scan crossed into the next block and the two
+      are merged), the tree is rebuilt from the block sums. That reads one sum per block and no token, and
+      a split needs BLOCK_TOKENS new tokens first.
+    - No views are stored. at(i) makes the token's view into the current source when it is asked for.
+    - Unexpected characters do not end the program here: the Lexer skips them and they are kept in the
+      blocks the same way, so an editor can show them while the user is still typing.
+*/
+class EditableTokens
+{
+public:
+    size_t size() const
+    {
+        return total.tokens;
+    }
+
+    Token at(size_t i) const
+    {
+        Entry entry = entryAt(i);
+        return Token{entry.type, src.substr(entry.offset, entry.length), entry.lineNumber, entry.id, entry.offset};
+    }
+
+    size_t errorCount() const
+    {
+        return total.errors;
+    }
+
+    LexError error(size_t i) const
+    {
+        size_t k = findBlock(i, &Sums::errors);
+        Sums start = prefix(k);
+        LexError error = blocks[k].errors[i];
+        error.offset += start.bytes;
+        error.lineNumber += 1 + start.lines;
+        return error;
+    }
+
+private:
+    friend class Lexer;
+
+    static constexpr size_t BLOCK_TOKENS = 512;
+
+    struct Entry
+    {
+        TokenType type;
+        uint32_t length;
+        uint32_t id;
+        size_t offset;
+        int lineNumber;
+    };
+
+    // Sizes of one block or of a run of blocks. Differences wrap around in the unsigned fields and come
+    // out right when they are added back.
+    struct Sums
+    {
+        size_t bytes = 0;
+        size_t tokens = 0;
+        size_t errors = 0;
+        int lines = 0; // line breaks
+
+        Sums &operator+=(const Sums &other)
+        {
+            bytes += other.bytes;
+            tokens += other.tokens;
+            errors += other.errors;
+            lines += other.lines;
+            return *this;
+        }
+
+        Sums &operator-=(const Sums &other)
+        {
+            bytes -= other.bytes;
+            tokens -= other.tokens;
+            errors -= other.errors;
+            lines -= other.lines;
+            return *this;
+        }
+    };
+
+    struct Block
+    {
+        vector<Entry> tokens;     // offsets and lines relative to the start of the block
+        vector<LexError> errors;  // the same
+        size_t bytes = 0;         // the block covers [start, start + bytes) of the source
+        int lines = 0;            // line breaks in that range
+
+        Sums sums() const
+        {
+            Sums sums;
+            sums.bytes = bytes;
+            sums.tokens = tokens.size();
+            sums.errors = errors.size();
+            sums.lines = lines;
+            return sums;
+        }
+    };
+
+    string_view src; // the source the tokens were lexed from; not owned
+    vector<Block> blocks;
+    vector<Sums> tree; // Fenwick tree over the sums of blocks, 1-based
+    Sums total;
+
+    // Sums of blocks [0, k)
+    Sums prefix(size_t k) const
+    {
+        Sums sums;
+        for (; k > 0; k &= k - 1)
+            sums += tree[k];
+        return sums;
+    }
+
+    void update(size_t k, const Sums &delta)
+    {
+        for (k++; k < tree.size(); k += k & -k)
+            tree[k] += delta;
+        total += delta;
+    }
+
+    void rebuild()
+    {
+        tree.assign(blocks.size() + 1, Sums());
+        total = Sums();
+        for (size_t k = 1; k < tree.size(); k++)
+        {
+            tree[k] += blocks[k - 1].sums();
+            total += blocks[k - 1].sums();
+            size_t parent = k + (k & -k);
+            if (parent < tree.size())
+                tree[parent] += tree[k];
+        }
+    }
+
+    // Block holding item i of field (the i-th token or error); i becomes its index inside the block.
+    size_t findBlock(size_t &i, size_t Sums::*field) const
+    {
+        size_t k = 0;
+        size_t step = 1;
+        while (step * 2 < tree.size())
+            step *= 2;
+        for (; step > 0; step /= 2)
+        {
+            if (k + step < tree.size() && tree[k + step].*field <= i)
+            {
+                k += step;
+                i -= tree[k].*field;
+            }
+        }
+        return k;
+    }
+
+    // The i-th token with its absolute offset and line number
+    Entry entryAt(size_t i) const
+    {
+        size_t k = findBlock(i, &Sums::tokens);
+        Sums start = prefix(k);
+        Entry entry = blocks[k].tokens[i];
+        entry.offset += start.bytes;
+        entry.lineNumber += 1 + start.lines;
+        return entry;
+    }
+
+    /*
+        Cuts the source range [start, end), lines startLine to endLine, with its tokens and errors at
+        absolute positions, into blocks. A block after the first starts at its first token. Up to twice
+        BLOCK_TOKENS stay in one block, so a block is not split again as soon as it grows past the limit.
+    */
+    static vector<Block> makeBlocks(size_t start, int startLine, size_t end, int endLine, const vector<Entry> &tokens,
+                                    const vector<LexError> &errors)
+    {
+        size_t perBlock = tokens.size() <= 2 * BLOCK_TOKENS ? max<size_t>(tokens.size(), 1) : BLOCK_TOKENS;
+        vector<Block> made((tokens.size() + perBlock - 1) / perBlock);
+        if (made.empty())
+            made.resize(1);
+        size_t nextError = 0;
+        for (size_t k = 0; k < made.size(); k++)
+        {
+            size_t first = k * perBlock;
+            size_t last = min(first + perBlock, tokens.size());
+            size_t blockStart = k == 0 ? start : tokens[first].offset;
+            int blockLine = k == 0 ? startLine : tokens[first].lineNumber;
+            size_t blockEnd = k + 1 < made.size() ? tokens[last].offset : end;
+            int blockEndLine = k + 1 < made.size() ? tokens[last].lineNumber : endLine;
+
+            Block &block = made[k];
+            block.bytes = blockEnd - blockStart;
+            block.lines = blockEndLine - blockLine;
+            for (size_t i = first; i < last; i++)
+            {
+                Entry entry = tokens[i];
+                entry.offset -= blockStart;
+                entry.lineNumber -= blockLine;
+                block.tokens.push_back(entry);
+            }
+            for (; nextError < errors.size() && (k + 1 == made.size() || errors[nextError].offset < blockEnd); nextError++)
+            {
+                LexError error = errors[nextError];
+                error.offset -= blockStart;
+                error.lineNumber -= blockLine;
+                block.errors.push_back(error);
+            }
+        }
+        return made;
+    }
+
+    /*
+        The splice behind Lexer::relex. Old tokens [first, resync) were re-scanned from restart (restartLine)
+        and came out as fresh, with freshErrors, in new positions. The old tokens from resync on stay, moved
+        by the edit: bytes later by shift (which may wrap around, i.e. be negative) and lines by lineShift.
+        Only the blocks from the one holding token first to the one holding token resync are rebuilt.
+    */
+    void splice(size_t first, size_t resync, size_t restart, int restartLine, const vector<Entry> &fresh,
+                const vector<LexError> &freshErrors, size_t shift, int lineShift)
+    {
+        size_t inFirst = first, inResync = resync;
+        size_t kb = findBlock(inFirst, &Sums::tokens);
+        size_t ke = findBlock(inResync, &Sums::tokens);
+        Sums before = prefix(kb);
+        size_t oldStart = before.bytes;
+        int oldStartLine = 1 + before.lines;
+        Sums through = prefix(ke + 1);
+        size_t oldResync = through.bytes - blocks[ke].bytes + blocks[ke].tokens[inResync].offset;
+
+        // The rebuilt range has to start at or before restart. If restart is in the previous block (in the
+        // space after its last token), that space is moved over, and any errors in it were re-scanned.
+        size_t start = oldStart;
+        int startLine = oldStartLine;
+        Sums previousDelta;
+        if (restart < oldStart)
+        {
+            Block &previous = blocks[kb - 1];
+            previousDelta -= previous.sums();
+            size_t previousStart = oldStart - previous.bytes;
+            while (!previous.errors.empty() && previousStart + previous.errors.back().offset >= restart)
+                previous.errors.pop_back();
+            previous.bytes -= oldStart - restart;
+            previous.lines -= oldStartLine - restartLine;
+            previousDelta += previous.sums();
+            start = restart;
+            startLine = restartLine;
+        }
+
+        vector<Entry> tokens;
+        vector<LexError> errors;
+        size_t errorsBefore = 0; // errors in front of restart; the fresh ones go after them
+        size_t blockStart = oldStart;
+        int blockLine = oldStartLine;
+        for (size_t k = kb; k <= ke; k++)
+        {
+            const Block &block = blocks[k];
+            if (k == kb)
+            {
+                for (size_t i = 0; i < inFirst; i++)
+                {
+                    Entry entry = block.tokens[i];
+                    entry.offset += blockStart;
+                    entry.lineNumber += blockLine;
+                    tokens.push_back(entry);
+                }
+                tokens.insert(tokens.end(), fresh.begin(), fresh.end());
+            }
+            if (k == ke)
+            {
+                for (size_t i = inResync; i < block.tokens.size(); i++)
+                {
+                    Entry entry = block.tokens[i];
+                    entry.offset += blockStart + shift;
+                    entry.lineNumber += blockLine + lineShift;
+                    tokens.push_back(entry);
+                }
+            }
+            for (const LexError &old : block.errors)
+            {
+                LexError error = old;
+                error.offset += blockStart;
+                error.lineNumber += blockLine;
+                if (error.offset < restart)
+                {
+                    errors.push_back(error);
+                    errorsBefore++;
+                }
+                else if (error.offset >= oldResync)
+                {
+                    error.offset += shift;
+                    error.lineNumber += lineShift;
+                    errors.push_back(error);
+                }
+            }
+            blockStart += block.bytes;
+            blockLine += block.lines;
+        }
+        errors.insert(errors.begin() + errorsBefore, freshErrors.begin(), freshErrors.end());
+
+        vector<Block> made = makeBlocks(start, startLine, blockStart + shift, blockLine + lineShift, tokens, errors);
+        if (kb > 0)
+            update(kb - 1, previousDelta);
+        if (ke == kb && made.size() == 1)
+        {
+            Sums delta = made[0].sums();
+            delta -= blocks[kb].sums();
+            blocks[kb] = move(made[0]);
+            update(kb, delta);
+            return;
+        }
+        blocks.erase(blocks.begin() + kb, blocks.begin() + ke + 1);
+        blocks.insert(blocks.begin() + kb, make_move_iterator(made.begin()), make_move_iterator(made.end()));
+        rebuild();
+    }
+};
+
+/*
+    StringInterner class:
+
+    Gives every distinct name a dense id (0, 1, 2, ... in order of first appearance). The Lexer interns
+    each identifier once, and from then on the parser, symbol table and code generators compare and
+    look up the uint32_t id instead of the string. The text is only needed again for output, through name(id).
+    - names keeps one copy of each distinct name; a deque never moves its elements, so the
+      string_view keys in ids stay valid as names grows.
+*/
+class StringInterner
+{
+public:
+    uint32_t intern(string_view text)
+    {
+        auto it = ids.find(text);
+        if (it != ids.end())
+            return it->second;
+        uint32_t id = static_cast<uint32_t>(names.size());
+        names.emplace_back(text);
+        ids.emplace(names.back(), id);
+        return id;
+    }
+
+    static constexpr uint32_t NOT_INTERNED = UINT32_MAX;
+
+    // The id of text, or NOT_INTERNED if it was never interned; unlike intern, this adds nothing.
+    uint32_t find(string_view text) const
+    {
+        auto it = ids.find(text);
+        return it == ids.end() ? NOT_INTERNED : it->second;
+    }
+
+    const string &name(uint32_t id) const
+    {
+        return names[id];
+    }
+
+    size_t size() const
+    {
+        return names.size();
+    }
+
+private:
+    deque<string> names;
+    unordered_map<string_view, uint32_t> ids;
+};
+
+/*
+    Keyword table:
+
+    Keywords are found with a perfect hash that is built at compile time. keywordHash mixes the
+    length, first and last character of a word; findKeywordSeed tries seeds until every keyword lands
+    in its own slot, and buildKeywordTable places each keyword in its slot. All of this is constexpr,
+    so at run time classifying a word costs one hash and one string compare.
+    To add a keyword, add it to KEYWORDS; the static_assert fails if no seed works for the new set.
+*/
+struct Keyword
+{
+    string_view text;
+    TokenType type;
+};
+
+constexpr Keyword KEYWORDS[] = {
+    {"int", T_INT},
+    {"if", T_IF},
+    {"else", T_ELSE},
+    {"for", T_FOR},
+    {"while", T_WHILE},
+    {"return", T_RETURN},
+};
+
+constexpr size_t KEYWORD_SLOTS = 16; // power of two, larger than the number of keywords
+
+constexpr size_t keywordHash(string_view word, size_t seed)
+{
+    return (word.size() + static_cast<unsigned char>(word[0]) * seed +
+            static_cast<unsigned char>(word[word.size() - 1])) & (KEYWORD_SLOTS - 1);
+}
+
+constexpr size_t findKeywordSeed()
+{
+    for (size_t seed = 1; seed < 1000; seed++)
+    {
+        bool used[KEYWORD_SLOTS] = {};
+        bool collision = false;
+        for (const Keyword &keyword : KEYWORDS)
+        {
+            size_t slot = keywordHash(keyword.text, seed);
+            if (used[slot])
+            {
+                collision = true;
+                break;
+            }
+            used[slot] = true;
+        }
+        if (!collision)
+            return seed;
+    }
+    return 0;
+}
+
+constexpr size_t KEYWORD_SEED = findKeywordSeed();
+static_assert(KEYWORD_SEED != 0, "No perfect hash seed found for KEYWORDS, increase KEYWORD_SLOTS.");
+
+struct KeywordTable
+{
+    Keyword slots[KEYWORD_SLOTS];
+};
+
+constexpr KeywordTable buildKeywordTable()
+{
+    KeywordTable table = {};
+    for (const Keyword &keyword : KEYWORDS)
+        table.slots[keywordHash(keyword.text, KEYWORD_SEED)] = keyword;
+    return table;
+}
+
+constexpr KeywordTable KEYWORD_TABLE = buildKeywordTable();
+
+// Returns the keyword token type for word, or T_ID when word is not a keyword. word must not be empty.
+inline TokenType keywordOrIdentifier(string_view word)
+{
+    const Keyword &slot = KEYWORD_TABLE.slots[keywordHash(word, KEYWORD_SEED)];
+    return slot.text == word ? slot.type : T_ID;
+}
+
+/*
+    Binary operator table:
+
+    The expression parser is driven by this table instead of one function per precedence level.
+    BINARY_OPERATORS lists every binary operator with its precedence (higher binds tighter) and the
+    text it gets in the three-address code; buildOperatorTable spreads it into OPERATOR_TABLE, indexed
+    by TokenType, at compile time. Tokens that are not binary operators get precedence 0, which ends
+    an expression. All operators are left-associative.
+    To add an operator, add its token to the Lexer and a line here.
+*/
+struct BinaryOperator
+{
+    TokenType type;
+    int precedence;
+    const char *text; // spelled with the surrounding spaces, e.g. " + "
+};
+
+constexpr BinaryOperator BINARY_OPERATORS[] = {
+    {T_EQ, 1, " == "},
+    {T_NEQ, 1, " != "},
+    {T_LT, 2, " < "},
+    {T_GT, 2, " > "},
+    {T_LTE, 2, " <= "},
+    {T_GTE, 2, " >= "},
+    {T_PLUS, 3, " + "},
+    {T_MINUS, 3, " - "},
+    {T_MUL, 4, " * "},
+    {T_DIV, 4, " / "},
+};
+
+struct OperatorTable
+{
+    BinaryOperator entries[T_EOF + 1];
 };
 
+constexpr OperatorTable buildOperatorTable()
+{
+    OperatorTable table = {};
+    for (const BinaryOperator &op : BINARY_OPERATORS)
+        table.entries[op.type] = op;
+    return table;
+}
+
+constexpr OperatorTable OPERATOR_TABLE = buildOperatorTable();
+
+// Returns the table entry for type; its precedence is 0 when type is not a binary operator.
+constexpr const BinaryOperator &binaryOperator(TokenType type)
+{
+    return OPERATOR_TABLE.entries[type];
+}
+
+// Token DFA generated by lexgen (lexgen.cpp) from cc.tokens: matchToken finds the longest token at a
+// position with one table lookup per byte. Regenerate with: lexgen cc.tokens > cc_dfa.h
+#include "cc_dfa.h"
+
+/*
+    Whitespace skipping:
+
+    skipSpace returns the index of the first non-whitespace byte at or after i (or n), and adds the
+    number of '\n' bytes it stepped over to newlines. Besides the scalar loop there are SSE2 (16 bytes
+    per step) and AVX2 (32 bytes per step) versions for x86-64; the fastest one the CPU supports is
+    picked once at startup, so long runs of indentation cost a few vector compares instead of one
+    isspace() call per byte.
+*/
+static inline bool isSpaceByte(char c)
+{
+    return c == ' ' || static_cast<unsigned char>(c - '\t') <= 4; // ' ', \t, \n, \v, \f, \r
+}
+
+static size_t skipSpaceScalar(const char *s, size_t i, size_t n, int &newlines)
+{
+    while (i < n && isSpaceByte(s[i]))
+    {
+        if (s[i] == '\n')
+            newlines++;
+        i++;
+    }
+    return i;
+}
+
+#if defined(__GNUC__) && defined(__x86_64__)
+static size_t skipSpaceSSE2(const char *s, size_t i, size_t n, int &newlines)
+{
+    const __m128i space = _mm_set1_epi8(' '), tab = _mm_set1_epi8('\t'), four = _mm_set1_epi8(4);
+    const __m128i newline = _mm_set1_epi8('\n');
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+        __m128i fromTab = _mm_sub_epi8(v, tab); // \t..\r become 0..4
+        __m128i isSpace = _mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(_mm_min_epu8(fromTab, four), fromTab));
+        unsigned stop = ~static_cast<unsigned>(_mm_movemask_epi8(isSpace)) & 0xFFFFu;
+        unsigned lines = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline)));
+        if (stop)
+        {
+            newlines += __builtin_popcount(lines & ((1u << __builtin_ctz(stop)) - 1));
+            return i + __builtin_ctz(stop);
+        }
+        newlines += __builtin_popcount(lines);
+    }
+    return skipSpaceScalar(s, i, n, newlines);
+}
+
+__attribute__((target("avx2"))) static size_t skipSpaceAVX2(const char *s, size_t i, size_t n, int &newlines)
+{
+    const __m256i space = _mm256_set1_epi8(' '), tab = _mm256_set1_epi8('\t'), four = _mm256_set1_epi8(4);
+    const __m256i newline = _mm256_set1_epi8('\n');
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+        __m256i fromTab = _mm256_sub_epi8(v, tab);
+        __m256i isSpace = _mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(_mm256_min_epu8(fromTab, four), fromTab));
+        unsigned stop = ~static_cast<unsigned>(_mm256_movemask_epi8(isSpace));
+        unsigned lines = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, newline)));
+        if (stop)
+        {
+            newlines += __builtin_popcount(lines & ((1u << __builtin_ctz(stop)) - 1));
+            return i + __builtin_ctz(stop);
+        }
+        newlines += __builtin_popcount(lines);
+    }
+    return skipSpaceSSE2(s, i, n, newlines);
+}
+#endif
+
+using SkipSpaceFn = size_t (*)(const char *, size_t, size_t, int &);
+
+static SkipSpaceFn selectSkipSpace()
+{
+#if defined(__GNUC__) && defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return skipSpaceAVX2;
+    return skipSpaceSSE2; // SSE2 is part of every x86-64 CPU
+#else
+    return skipSpaceScalar;
+#endif
+}
+
+static const SkipSpaceFn skipSpace = selectSkipSpace();
+
 struct Point
 {
     int x;
     int y;
 };
 
+/*
+    Lexer class:
+
+    The Lexer is a pull lexer: the parser asks for tokens one at a time with next() and looks ahead
+    with peek(k), and the Lexer scans the source only as far as the parser has looked. Tokens that
+    have been scanned but not consumed yet live in a small ring buffer, so memory for tokens stays
+    constant no matter how large the source is.
+
+    - peek(k):   returns the k-th unconsumed token without consuming it (k < LOOKAHEAD).
+    - next():    consumes and returns the current token. At the end of input it keeps returning T_EOF.
+    - tokenize(): wrapper that pulls every token into a vector, for callers that want them all.
+    - tokenizeForEditing() and relex(): for an editor, keep EditableTokens up to date edit by edit.
+
+    Compiled with -DCC_FLEX_LEXER, tokens are scanned by the reentrant flex scanner generated from cc.l
+    instead of the hand-written scanToken below; both produce the same Token stream.
+*/
+#ifdef CC_FLEX_LEXER
+#include "cc.yy.c" // flex -o cc.yy.c cc.l; defines scanFlexToken
+#endif
+
 class Lexer
 {
 private:
-    string src;
+    string_view src; // not owned, the caller keeps the buffer alive while the tokens are in use
     size_t pos;
     int lineNumber;
+    StringInterner &names; // identifiers are interned here as they are scanned
+
+#ifdef CC_FLEX_LEXER
+    string flexBuffer;                  // src plus the two NUL bytes yy_scan_buffer needs; flex writes into it
+    yyscan_t scanner = nullptr;
+    YY_BUFFER_STATE flexState = nullptr; // null once the scanner has reached the end of input
+#endif
+
+    static constexpr size_t LOOKAHEAD = 4; // ring buffer size, must be a power of two
+    static_assert((LOOKAHEAD & (LOOKAHEAD - 1)) == 0, "LOOKAHEAD must be a power of two");
+    Token ring[LOOKAHEAD];
+    size_t head = 0;  // slot of the oldest buffered token
+    size_t count = 0; // number of buffered tokens
+
+    // Where unexpected characters are recorded while lexing for an editor; null means they end the program.
+    vector<LexError> *unexpected = nullptr;
 
 public:
-    Lexer(const string &src) : src(src), pos(0), lineNumber(1) {}
+    Lexer(string_view src, StringInterner &names) : src(src), pos(0), lineNumber(1), names(names)
+    {
+#ifdef CC_FLEX_LEXER
+        flexBuffer.reserve(src.size() + 2);
+        flexBuffer.assign(src);
+        flexBuffer.append(2, YY_END_OF_BUFFER_CHAR);
+        yylex_init(&scanner);
+        seek(0, 1);
+#endif
+    }
+
+#ifdef CC_FLEX_LEXER
+    ~Lexer()
+    {
+        yylex_destroy(scanner); // also frees flexState
+    }
+
+    Lexer(const Lexer &) = delete;
+    Lexer &operator=(const Lexer &) = delete;
+#endif
+
+    // k must be below LOOKAHEAD: the ring holds that many tokens, and a deeper peek would overwrite
+    // buffered tokens that have not been consumed yet.
+    const Token &peek(size_t k = 0)
+    {
+        assert(k < LOOKAHEAD);
+        while (count <= k)
+        {
+            ring[(head + count) & (LOOKAHEAD - 1)] = scanToken();
+            count++;
+        }
+        return ring[(head + k) & (LOOKAHEAD - 1)];
+    }
+
+    Token next()
+    {
+        Token token = peek();
+        head = (head + 1) & (LOOKAHEAD - 1);
+        count--;
+        return token;
+    }
 
     vector<Token> tokenize()
     {
         vector<Token> tokens;
-        while (pos < src.size())
+        do
+        {
+            tokens.push_back(next());
+        } while (tokens.back().type != T_EOF);
+        return tokens;
+    }
+
+    // Lexes the whole source for an editor: like tokenize(), but into EditableTokens for relex, and
+    // unexpected characters are skipped and recorded there instead of ending the program.
+    EditableTokens tokenizeForEditing()
+    {
+        head = count = 0;
+        seek(0, 1);
+        vector<EditableTokens::Entry> entries;
+        vector<LexError> errors;
+        unexpected = &errors;
+        Token token;
+        do
+        {
+            token = scanToken();
+            entries.push_back(editableEntry(token));
+        } while (token.type != T_EOF);
+        unexpected = nullptr;
+
+        EditableTokens tokens;
+        tokens.src = src;
+        tokens.blocks = EditableTokens::makeBlocks(0, 1, src.size(), token.lineNumber, entries, errors);
+        tokens.rebuild();
+        return tokens;
+    }
+
+    /*
+        relex updates tokens, the result of tokenizeForEditing() on the old source, to newSource, which is
+        the old source with edit applied, and makes newSource this Lexer's source. The result is the same as
+        tokenizeForEditing() on newSource. It returns false if the new source has unexpected characters;
+        they are in tokens' errors, and never end the program.
+        - The lexer carries no state between tokens other than the line number (there are no comments or
+          strings), so the end of the last token that ends before the edit is a safe restart point:
+          that token cannot change, since the character after it is unchanged.
+        - Scanning goes on from there until a new token starts past the inserted text exactly where an old
+          token started (shifted by the edit). That token and the ones after it are what a full lex would
+          give, so they are kept.
+        - EditableTokens::splice puts the new tokens in. Only the blocks holding re-scanned tokens are
+          rebuilt; the tokens after them are not visited, since block positions are sums kept in a tree.
+        So the work is the re-scan around the edit plus O(BLOCK_TOKENS + log blocks), however large the
+        file is (except with the flex backend, which copies newSource into its own buffer).
+        relex drops any tokens buffered for peek() and next().
+    */
+    bool relex(EditableTokens &tokens, string_view newSource, const TextEdit &edit)
+    {
+        // First old token that ends at or after the edit; everything in front of it is unaffected.
+        size_t low = 0, high = tokens.size() - 1; // the T_EOF token ends at the end, never before the edit
+        while (low < high)
         {
-            char current = src[pos];
+            size_t middle = low + (high - low) / 2;
+            EditableTokens::Entry entry = tokens.entryAt(middle);
+            if (entry.offset + entry.length < edit.offset)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        size_t first = low;
+        size_t restart = 0;
+        int restartLine = 1;
+        if (first > 0)
+        {
+            EditableTokens::Entry last = tokens.entryAt(first - 1);
+            restart = last.offset + last.length;
+            restartLine = last.lineNumber;
+        }
 
-            if (current == '\n')
+        setSource(newSource);
+        head = count = 0;
+        seek(restart, restartLine);
+        vector<EditableTokens::Entry> fresh;
+        vector<LexError> freshErrors;
+        unexpected = &freshErrors;
+        size_t editEnd = edit.offset + edit.inserted; // end of the inserted text in the new source
+        size_t resync = first;                          // candidate old token to resynchronize on
+        EditableTokens::Entry old = tokens.entryAt(resync);
+        int lineShift;
+        while (true)
+        {
+            Token token = scanToken();
+            if (token.offset >= editEnd)
             {
-                lineNumber++;
-                pos++;
-                continue;
+                size_t oldOffset = token.offset - edit.inserted + edit.removed;
+                while (old.offset < oldOffset && old.type != T_EOF)
+                    old = tokens.entryAt(++resync);
+                if (old.offset == oldOffset)
+                {
+                    lineShift = token.lineNumber - old.lineNumber;
+                    break;
+                }
             }
-            if (isspace(current))
+            fresh.push_back(editableEntry(token));
+        }
+        unexpected = nullptr;
+
+        tokens.splice(first, resync, restart, restartLine, fresh, freshErrors, edit.inserted - edit.removed, lineShift);
+        tokens.src = newSource;
+        return tokens.errorCount() == 0;
+    }
+
+private:
+#ifdef CC_FLEX_LEXER
+    // Flex backend: the scanner works on its own copy of the source, which has to be made again.
+    void setSource(string_view newSource)
+    {
+        src = newSource;
+        flexBuffer.assign(src);
+        flexBuffer.append(2, YY_END_OF_BUFFER_CHAR);
+    }
+
+    // Flex backend: restarts the scanner on the rest of the buffer from newPos.
+    void seek(size_t newPos, int newLine)
+    {
+        pos = newPos;
+        lineNumber = newLine;
+        if (flexState)
+            yy_delete_buffer(flexState, scanner);
+        flexState = yy_scan_buffer(&flexBuffer[pos], flexBuffer.size() - pos, scanner);
+        yyset_lineno(lineNumber, scanner);
+    }
+
+    // Flex backend: the scanner returns the token type, and yytext/yyleng locate the lexeme in flexBuffer,
+    // which lines up byte for byte with src, so the Token views src just like the hand-written scanner's.
+    Token scanToken()
+    {
+        while (true)
+        {
+            if (!flexState)
+                return Token{T_EOF, src.substr(pos, 0), lineNumber, 0, pos};
+
+            int kind = scanFlexToken(scanner);
+            lineNumber = yyget_lineno(scanner);
+            if (kind == T_EOF)
             {
-                pos++;
-                continue;
+                yy_delete_buffer(flexState, scanner);
+                flexState = nullptr;
+                pos = src.size();
+                return Token{T_EOF, src.substr(pos, 0), lineNumber, 0, pos};
             }
-            if (isdigit(current))
+
+            size_t start = yyget_text(scanner) - flexBuffer.data();
+            pos = start + yyget_leng(scanner);
+            // Flex parks a NUL after the lexeme until its next call; put the source byte back right away,
+            // so a seek() into the rest of the buffer never sees it.
+            if (pos < src.size())
+                flexBuffer[pos] = src[pos];
+            if (kind < 0)
             {
-                tokens.push_back(Token{T_NUM, consumeNumber(), lineNumber});
+                unexpectedCharacter(start);
                 continue;
             }
-            if (isalpha(current))
+            TokenType type = static_cast<TokenType>(kind);
+            string_view value = src.substr(start, pos - start);
+            return Token{type, value, lineNumber, type == T_ID ? names.intern(value) : 0, start};
+        }
+    }
+#else
+    void setSource(string_view newSource)
+    {
+        src = newSource;
+    }
+
+    void seek(size_t newPos, int newLine)
+    {
+        pos = newPos;
+        lineNumber = newLine;
+    }
+
+    // Scans one token starting at pos, skipping any whitespace in front of it. The token itself is
+    // matched by the generated DFA (cc_dfa.h).
+    Token scanToken()
+    {
+        while (true)
+        {
+            if (pos < src.size() && isspace(src[pos]))
+                pos = skipSpace(src.data(), pos, src.size(), lineNumber);
+            if (pos >= src.size())
+                return Token{T_EOF, src.substr(pos, 0), lineNumber, 0, pos};
+
+            size_t length;
+            int kind = matchToken(src.data() + pos, src.data() + src.size(), length);
+            if (kind < 0)
             {
-                string word = consumeWord();
-                TokenType type = T_ID;
-
-                if (word == "int")
-                    type = T_INT;
-                else if (word == "if")
-                    type = T_IF;
-                else if (word == "else")
-                    type = T_ELSE;
-                else if (word == "for")
-                    type = T_FOR;
-                else if (word == "while")
-                    type = T_WHILE;
-                else if (word == "return")
-                    type = T_RETURN;
-
-                tokens.push_back(Token{type, word, lineNumber});
+                unexpectedCharacter(pos);
+                pos++;
                 continue;
             }
-
-            switch (current)
+            size_t start = pos;
+            pos += length;
+            string_view value = src.substr(start, length);
+            TokenType type = static_cast<TokenType>(kind);
+            if (type == T_ID)
             {
-            case '=':
-                tokens.push_back(Token{T_ASSIGN, "=", lineNumber});
-                break;
-            case '+':
-                tokens.push_back(Token{T_PLUS, "+", lineNumber});
-                break;
-            case '-':
-                tokens.push_back(Token{T_MINUS, "-", lineNumber});
-                break;
-            case '*':
-                tokens.push_back(Token{T_MUL, "*", lineNumber});
-                break;
-            case '/':
-                tokens.push_back(Token{T_DIV, "/", lineNumber});
-                break;
-            case '(':
-                tokens.push_back(Token{T_LPAREN, "(", lineNumber});
-                break;
-            case ')':
-                tokens.push_back(Token{T_RPAREN, ")", lineNumber});
-                break;
-            case '{':
-                tokens.push_back(Token{T_LBRACE, "{", lineNumber});
-                break;
-            case '}':
-                tokens.push_back(Token{T_RBRACE, "}", lineNumber});
-                break;
-            case ';':
-                tokens.push_back(Token{T_SEMICOLON, ";", lineNumber});
-                break;
-            case '>':
-                tokens.push_back(Token{T_GT, ">", lineNumber});
-                break;
-            default:
-                cout << "Unexpected character: " << current << " at line " << lineNumber << endl;
-                exit(1);
+                type = keywordOrIdentifier(value);
+                if (type == T_ID)
+                    return Token{T_ID, value, lineNumber, names.intern(value), start};
             }
-            pos++;
+            return Token{type, value, lineNumber, 0, start};
         }
-        tokens.push_back(Token{T_EOF, "", lineNumber});
-        return tokens;
     }
+#endif
+
+    static EditableTokens::Entry editableEntry(const Token &token)
+    {
+        return EditableTokens::Entry{token.type, static_cast<uint32_t>(token.value.size()), token.id, token.offset,
+                                     token.lineNumber};
+    }
+
+    // An unexpected character ends the program, unless the Lexer is lexing for an editor; then it is
+    // recorded and skipped.
+    void unexpectedCharacter(size_t at)
+    {
+        if (!unexpected)
+        {
+            cout << "Unexpected character: " << src[at] << " at line " << lineNumber << endl;
+            exit(1);
+        }
+        unexpected->push_back(LexError{at, lineNumber, src[at]});
+    }
+};
+
+// Data types of variables. Only int exists so far; the symbol table stores a type as one byte.
+enum DataType : uint8_t
+{
+    TYPE_INT
+};
+
+/*
+    SymbolTable class:
+
+    The SymbolTable class manages a collectin of variable names and their associated data types.
+    It serves as a fundamental part of a compiler or interpreter, ensuring that variables are properly declared
+    and accessed with their correct types during semantic analysis.
+
+    Variables are scoped by blocks: a variable declared inside { } is only visible up to the closing brace,
+    and may shadow a variable of the same name declared outside. A single flat table, innermost, gives
+    for every variable the index of its innermost declaration, so a lookup is one array access however
+    deep the nesting is. Declarations are kept in order in bindings, each one remembering the declaration
+    it shadows; this doubles as the undo log of the scopes, since leaving a scope pops the declarations
+    made in it and puts back what they shadowed.
+
+
+    Member Functions:
+    Variables are identified by the id the StringInterner gave their name. Those ids are dense
+    (0, 1, 2, ...), so they index innermost directly: no string is hashed or compared here, and no
+    hashing of the id is needed either. The interner is only asked for the name when an error message is built.
+
+    1. enterScope() / exitScope():
+       - Purpose: Open a scope at '{' and close it at the matching '}'.
+       - enterScope only records where the declarations of the new scope start in bindings, so it is O(1).
+       - exitScope undoes the declarations made since then, so it is O(variables declared in the scope).
+
+       while (bindings.size() > scopeStarts.back()) {
+           innermost[bindings.back().id] = bindings.back().shadowed;
+           bindings.pop_back();
+       }
+
+    2. declareVariable(uint32_t id, DataType type):
+       - Purpose: Declares a new variable with a specified name and type in the current scope.
+       - This function checks if the variable is already declared in the current scope. If it is, a runtime error
+         is thrown indicating that the variable has already been declared.
+       - A declaration of the same name in an enclosing scope is shadowed until the current scope ends.
+       - It will throw a runtime error if the variable already exists in the current scope.
+       - Example usage: Declare a new variable x with type int.
+
+       if (innermost[id] != NONE && innermost[id] >= scopeStart()) {
+           throw runtime_error("Semantic error: Variable '" + names.name(id) + "' is already declared.");
+       }
+
+    3. getVariableType(uint32_t id):
+       - Purpose: Returns the type of a variable given its name.
+       - This function checks if the variable is visible. If the variable is not found, it throws
+         a runtime error indicating that the variable has not been declared yet.
+       - If the variable is declared, it returns the type of its innermost declaration, a one-byte DataType
+         rather than a copy of a type name.
+       - Throws a runtime error if the variable is not found.
+       - Example usage: Get the type of variable x.
+
+       if (id >= innermost.size() || innermost[id] == NONE) {
+           throw runtime_error("Semantic error: Variable '" + names.name(id) + "' is not declared.");
+       }
+       return bindings[innermost[id]].type;
+
+    4. isDeclared(uint32_t id) const:
+       - Purpose: Checks whether a variable is visible in the current scope.
+       - It is a quick way to check the existence of a variable without retrieving its type.
+       - Example usage: Check if variable x is declared.
+
+       return id < innermost.size() && innermost[id] != NONE;
+
+    Private Data Members:
+
+    - vector<uint32_t> innermost:
+      - For each variable id, the index in bindings of its innermost declaration, or NONE. It grows to
+        the largest id declared so far.
+    - vector<Binding> bindings:
+      - The declarations of all open scopes, outermost first, each with its type and the index of the
+        declaration it shadows (NONE if it shadows nothing).
+    - vector<size_t> scopeStarts:
+      - For each open scope, the size bindings had when it was entered. The outermost (global) scope
+        has no entry and starts at 0.
+
+    Usage in a Compiler or Interpreter:
+    - The SymbolTable is crucial for ensuring that variables are used consistently and correctly in a program.
+    - When a variable is declared, it is added to the symbol table, and its type is stored.
+    - When a variable is referenced, the symbol table is consulted to ensure that it has been declared and to retrieve its type.
+    - The symbol table helps detect semantic errors such as undeclared variables or redeclared variables.
+*/
+class SymbolTable
+{
+public:
+    SymbolTable(const StringInterner &names) : names(names) {}
+
+    void enterScope()
+    {
+        scopeStarts.push_back(bindings.size());
+    }
+
+    void exitScope()
+    {
+        size_t start = scopeStarts.back();
+        scopeStarts.pop_back();
+        while (bindings.size() > start)
+        {
+            innermost[bindings.back().id] = bindings.back().shadowed;
+            bindings.pop_back();
+        }
+    }
+
+    void declareVariable(uint32_t id, DataType type)
+    {
+        if (id >= innermost.size())
+        {
+            innermost.resize(max<size_t>(id + 1, innermost.size() * 2), NONE);
+        }
+        uint32_t shadowed = innermost[id];
+        if (shadowed != NONE && shadowed >= scopeStart())
+        {
+            throw runtime_error("Semantic error: Variable '" + names.name(id) + "' is already declared.");
+        }
+        innermost[id] = static_cast<uint32_t>(bindings.size());
+        bindings.push_back(Binding{id, shadowed, type});
+    }
+
+    DataType getVariableType(uint32_t id) const
+    {
+        if (!isDeclared(id))
+        {
+            throw runtime_error("Semantic error: Variable '" + names.name(id) + "' is not declared.");
+        }
+        return bindings[innermost[id]].type;
+    }
+
+    bool isDeclared(uint32_t id) const
+    {
+        return id < innermost.size() && innermost[id] != NONE;
+    }
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
 
-    string consumeNumber()
+    struct Binding
     {
-        size_t start = pos;
-        while (pos < src.size() && isdigit(src[pos]))
-            pos++;
-        return src.substr(start, pos - start);
+        uint32_t id;
+        uint32_t shadowed; // index of the declaration this one shadows, or NONE
+        DataType type;
+    };
+
+    const StringInterner &names; // only used to put the variable name into error messages
+    vector<uint32_t> innermost;
+    vector<Binding> bindings;
+    vector<size_t> scopeStarts;
+
+    size_t scopeStart() const
+    {
+        return scopeStarts.empty() ? 0 : scopeStarts.back();
     }
+};
+
+/*
+    Arena class:
+
+    A bump allocator for the AST. Nodes are carved one after another out of large blocks, so an
+    allocation is a pointer bump, nodes built together sit next to each other in memory, and the
+    whole tree is freed in one shot when the Arena goes away (no per-node delete, no destructors).
+    Only trivially destructible types may be allocated from it.
 
-    string consumeWord()
+    - make<T>(args...): constructs a T in the arena and returns a pointer to it.
+    - bytesUsed(), objects(): totals for measuring the size of a tree.
+*/
+class Arena
+{
+public:
+    Arena() = default;
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    template <typename T, typename... Args>
+    T *make(Args &&...args)
+    {
+        static_assert(is_trivially_destructible<T>::value, "arena objects are never destroyed");
+        return new (allocate(sizeof(T), alignof(T))) T(forward<Args>(args)...);
+    }
+
+    size_t bytesUsed() const { return used; }
+    size_t objects() const { return count; }
+
+private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    vector<unique_ptr<char[]>> blocks;
+    char *cur = nullptr;
+    char *end = nullptr;
+    size_t used = 0;
+    size_t count = 0;
+
+    void *allocate(size_t size, size_t align)
     {
-        size_t start = pos;
-        while (pos < src.size() && isalnum(src[pos]))
-            pos++;
-        return src.substr(start, pos - start);
+        size_t padding = (align - reinterpret_cast<uintptr_t>(cur) % align) % align;
+        if (cur == nullptr || size + padding > size_t(end - cur))
+        {
+            size_t blockSize = max(BLOCK_SIZE, size + align); // oversized objects get a block of their own
+            blocks.emplace_back(new char[blockSize]);
+            cur = blocks.back().get();
+            end = cur + blockSize;
+            padding = (align - reinterpret_cast<uintptr_t>(cur) % align) % align;
+        }
+        void *p = cur + padding;
+        cur += padding + size;
+        used += padding + size;
+        count++;
+        return p;
     }
 };
 
 /*
-    SymbolTable class:
+    AST nodes:
+
+    Every node starts with its kind, so a Node pointer is downcast with static_cast after checking kind.
+    Expressions (N_BINOP, N_LITERAL, N_VAR) and statements (everything else) are separate bases;
+    statements carry a next pointer, so the statements of a block (and of the whole program) form a
+    singly linked list instead of needing a separately allocated array. Names and literals are views
+    into the source and identifiers also keep their interned id, so no node owns memory and the tree
+    lives entirely in the Arena that built it.
+*/
+enum NodeKind : uint8_t
+{
+    N_DECL,
+    N_ASSIGN,
+    N_IF,
+    N_WHILE,
+    N_FOR,
+    N_RETURN,
+    N_BLOCK,
+    N_BINOP,
+    N_LITERAL,
+    N_VAR
+};
 
-    The SymbolTable class manages a collectin of variable names and their associated data types.
-    It serves as a fundamental part of a compiler or interpreter, ensuring that variables are properly declared
-    and accessed with their correct types during semantic analysis.
+struct Node
+{
+    NodeKind kind;
+    explicit Node(NodeKind kind) : kind(kind) {}
+};
 
+struct Expr : Node
+{
+    using Node::Node;
+};
 
-    Member Functions:
-    1. declareVariable(const string &name, const string &type):
-       - Purpose: Declares a new variable with a specified name and type.
-       - This function checks if the variable is already declared. If it is, a runtime error is thrown indicating
-         that the variable has already been declared.
-       - If the variable is not already declared, it adds the variable's name as a key and its type as the value
-         to the symbolTable map.
-       - It will throw a runtime error if the variable already exists in the symbol table.
-       - Example usage: Declare a new variable x with type int.
+struct Stmt : Node
+{
+    Stmt *next = nullptr; // next statement in the enclosing block
+    using Node::Node;
+};
 
-       if (symbolTable.find(name) != symbolTable.end()) {
-           throw runtime_error("Semantic error: Variable '" + name + "' is already declared.");
-       }
-       symbolTable[name] = type;
+struct BinaryExpr : Expr
+{
+    TokenType op; // a token with an entry in OPERATOR_TABLE
+    Expr *left;
+    Expr *right;
+    BinaryExpr(TokenType op, Expr *left, Expr *right) : Expr(N_BINOP), op(op), left(left), right(right) {}
+};
 
-    2. getVariableType(const string &name):
-       - Purpose: Returns the type of a variable given its name.
-       - This function checks if the variable exists in the symbolTable. If the variable is not found, it throws
-         a runtime error indicating that the variable has not been declared yet.
-       - If the variable is declared, it retrieves and returns its associated type from the symbol table.
-       - Throws a runtime error if the variable is not found.
-       - Example usage: Get the type of variable x.
+struct LiteralExpr : Expr
+{
+    string_view text;
+    explicit LiteralExpr(string_view text) : Expr(N_LITERAL), text(text) {}
+};
 
-       if (symbolTable.find(name) == symbolTable.end()) {
-           throw runtime_error("Semantic error: Variable '" + name + "' is not declared.");
-       }
-       return symbolTable[name];
+struct VarExpr : Expr
+{
+    string_view name;
+    uint32_t id;
+    VarExpr(string_view name, uint32_t id) : Expr(N_VAR), name(name), id(id) {}
+};
 
-    3. isDeclared(const string &name) const:
-       - Purpose: Checks whether a variable has been declared.
-       - This function returns a boolean value indicating whether the variable exists in the symbolTable.
-       - It is a quick way to check the existence of a variable without retrieving its type.
-       - Example usage: Check if variable x is declared.
+struct DeclStmt : Stmt
+{
+    string_view name;
+    uint32_t id;
+    DeclStmt(string_view name, uint32_t id) : Stmt(N_DECL), name(name), id(id) {}
+};
+
+struct AssignStmt : Stmt
+{
+    string_view name;
+    uint32_t id;
+    Expr *value;
+    AssignStmt(string_view name, uint32_t id, Expr *value) : Stmt(N_ASSIGN), name(name), id(id), value(value) {}
+};
 
-       return symbolTable.find(name) != symbolTable.end();
+struct IfStmt : Stmt
+{
+    Expr *condition;
+    Stmt *thenBranch;
+    Stmt *elseBranch; // null when there is no else
+    IfStmt(Expr *condition, Stmt *thenBranch, Stmt *elseBranch)
+        : Stmt(N_IF), condition(condition), thenBranch(thenBranch), elseBranch(elseBranch) {}
+};
 
-    Private Data Members:
+struct WhileStmt : Stmt
+{
+    Expr *condition;
+    Stmt *body;
+    WhileStmt(Expr *condition, Stmt *body) : Stmt(N_WHILE), condition(condition), body(body) {}
+};
 
-    - map<string, string> symbolTable:
-      - A map that stores variable names (strings) as keys and their associated types (strings) as values.
-      - This map allows efficient lookups to check if a variable is declared and to retrieve its type.
+struct ForStmt : Stmt
+{
+    AssignStmt *init;
+    Expr *condition;
+    AssignStmt *update;
+    Stmt *body;
+    ForStmt(AssignStmt *init, Expr *condition, AssignStmt *update, Stmt *body)
+        : Stmt(N_FOR), init(init), condition(condition), update(update), body(body) {}
+};
 
-    Usage in a Compiler or Interpreter:
-    - The SymbolTable is crucial for ensuring that variables are used consistently and correctly in a program.
-    - When a variable is declared, it is added to the symbol table, and its type is stored.
-    - When a variable is referenced, the symbol table is consulted to ensure that it has been declared and to retrieve its type.
-    - The symbol table helps detect semantic errors such as undeclared variables or redeclared variables.
+struct ReturnStmt : Stmt
+{
+    Expr *value;
+    explicit ReturnStmt(Expr *value) : Stmt(N_RETURN), value(value) {}
+};
+
+struct BlockStmt : Stmt
+{
+    Stmt *first; // first statement of the block, the rest follow through next
+    explicit BlockStmt(Stmt *first) : Stmt(N_BLOCK), first(first) {}
+};
+
+/*
+    IntermediateCodeGnerator class:
+
+    Generates the three-address code for a program by walking its AST; generate(program) appends the
+    instructions for every statement of the program block to instructions. Temporaries and loop labels
+    share the tempCount counter, and they are numbered in the order the walk reaches them.
 */
-class SymbolTable
+class IntermediateCodeGnerator
 {
 public:
-    void declareVariable(const string &name, const string &type)
+    vector<string> instructions;
+    int tempCount = 0;
+
+    string newTemp()
     {
-        if (symbolTable.find(name) != symbolTable.end())
-        {
-            throw runtime_error("Semantic error: Variable '" + name + "' is already declared.");
-        }
-        symbolTable[name] = type;
+        return "t" + to_string(tempCount++);
+    }
+
+    void addInstruction(string instr)
+    {
+        instructions.push_back(move(instr)); // callers pass temporaries, so this moves instead of copying
     }
 
-    string getVariableType(const string &name)
+    void printInstructions()
     {
-        if (symbolTable.find(name) == symbolTable.end())
+        for (const auto &instr : instructions)
         {
-            throw runtime_error("Semantic error: Variable '" + name + "' is not declared.");
+            cout << instr << endl;
         }
-        return symbolTable[name];
     }
 
-    bool isDeclared(const string &name) const
+    /*
+        generate walks the statements with an explicit stack of Steps on the heap instead of recursing,
+        so the nesting depth of the program is bounded only by memory. A Step either starts a statement
+        (phase 0) or finishes one whose body has just been generated (phase 1, and phase 2 after an else).
+        Starting a statement that belongs to a block also schedules its next sibling, below the steps
+        for the statement itself, so the siblings follow once the statement is done.
+    */
+    void generate(const BlockStmt *program)
     {
-        return symbolTable.find(name) != symbolTable.end();
+        vector<Step> steps;
+        if (program->first)
+        {
+            steps.push_back(Step{program->first, 0, 0, 0});
+        }
+        while (!steps.empty())
+        {
+            Step step = steps.back();
+            steps.pop_back();
+            if (step.phase == 0 && step.stmt->next)
+            {
+                steps.push_back(Step{step.stmt->next, 0, 0, 0});
+            }
+            generateStep(step, steps);
+        }
     }
 
 private:
-    map<string, string> symbolTable;
-};
+    struct Step
+    {
+        const Stmt *stmt;
+        int phase;
+        int startLabel; // loop labels, kept from the start of a loop for its end
+        int endLabel;
+    };
 
-class IntermediateCodeGnerator
-{
-public:
-    vector<string> instructions;
-    int tempCount = 0;
+    void generateStep(const Step &step, vector<Step> &steps)
+    {
+        switch (step.stmt->kind)
+        {
+        case N_DECL: // declarations only matter to the symbol table
+            break;
+        case N_ASSIGN:
+            generateAssignment(static_cast<const AssignStmt *>(step.stmt));
+            break;
+        case N_IF:
+        {
+            auto ifStmt = static_cast<const IfStmt *>(step.stmt);
+            if (step.phase == 0)
+            {
+                string cond = generateExpression(ifStmt->condition);
+                string temp = newTemp();             // Generate a new temporary variable for the condition result.
+                addInstruction(temp + " = " + cond); // Generate intermediate code for storing the condition result.
 
-    string newTemp()
+                addInstruction("if " + temp + " goto L1"); // Jump to label L1 if condition is true.
+                addInstruction("goto L2");                 // Otherwise, jump to label L2.
+                addInstruction("L1:");
+
+                steps.push_back(Step{ifStmt, 1, 0, 0});
+                steps.push_back(Step{ifStmt->thenBranch, 0, 0, 0});
+            }
+            else if (step.phase == 1 && ifStmt->elseBranch)
+            {
+                addInstruction("goto L3");
+                addInstruction("L2:");
+                steps.push_back(Step{ifStmt, 2, 0, 0});
+                steps.push_back(Step{ifStmt->elseBranch, 0, 0, 0});
+            }
+            else
+            {
+                addInstruction(step.phase == 1 ? "L2:" : "L3:");
+            }
+            break;
+        }
+        case N_WHILE:
+        {
+            auto loop = static_cast<const WhileStmt *>(step.stmt);
+            if (step.phase == 0)
+            {
+                int startLabel = tempCount++; // Start of the loop.
+                addInstruction("L" + to_string(startLabel) + ":");
+                int endLabel = generateCondition(loop->condition);
+                steps.push_back(Step{loop, 1, startLabel, endLabel});
+                steps.push_back(Step{loop->body, 0, 0, 0});
+            }
+            else
+            {
+                addInstruction("goto L" + to_string(step.startLabel)); // Jump back to the start of the loop.
+                addInstruction("L" + to_string(step.endLabel) + ":");
+            }
+            break;
+        }
+        case N_FOR:
+        {
+            auto loop = static_cast<const ForStmt *>(step.stmt);
+            if (step.phase == 0)
+            {
+                generateAssignment(loop->init);
+                int startLabel = tempCount++; // Start of the loop.
+                addInstruction("L" + to_string(startLabel) + ":");
+                int endLabel = generateCondition(loop->condition);
+                steps.push_back(Step{loop, 1, startLabel, endLabel});
+                steps.push_back(Step{loop->body, 0, 0, 0});
+            }
+            else
+            {
+                string loopUpdateLabel = "L" + to_string(tempCount++); // Label for update.
+                addInstruction(loopUpdateLabel + ":");
+                generateAssignment(loop->update);
+
+                addInstruction("goto L" + to_string(step.startLabel)); // Jump back to the loop start.
+                addInstruction("L" + to_string(step.endLabel) + ":");   // Label for loop exit.
+            }
+            break;
+        }
+        case N_RETURN:
+        {
+            string expr = generateExpression(static_cast<const ReturnStmt *>(step.stmt)->value);
+            addInstruction("return " + expr);
+            break;
+        }
+        case N_BLOCK:
+        {
+            const Stmt *first = static_cast<const BlockStmt *>(step.stmt)->first;
+            if (first)
+            {
+                steps.push_back(Step{first, 0, 0, 0});
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    void generateAssignment(const AssignStmt *assign)
     {
-        return "t" + to_string(tempCount++);
+        string expr = generateExpression(assign->value);
+        addInstruction(string(assign->name) + " = " + expr);
     }
 
-    void addInstruction(const string &instr)
+    // Emits the loop condition and the jump out of the loop, and returns the number of the exit label.
+    int generateCondition(const Expr *condition)
     {
-        instructions.push_back(instr);
+        string value = generateExpression(condition);
+        string conditionResult = newTemp(); // Temporary variable for condition result.
+        addInstruction(conditionResult + " = " + value);
+
+        int endLabel = tempCount++; // Label for exiting the loop.
+        addInstruction("if " + conditionResult + " == 0 goto L" + to_string(endLabel));
+        return endLabel;
     }
 
-    void printInstructions()
+    // Emits the code for expr, operands before the operation, and returns the name holding its value:
+    // the literal or variable itself, or the temporary of the last operation.
+    // Operator chains lean left ((a + b) + c ...), so the left spine is walked with a loop and only
+    // right operands recurse; a long chain does not grow the C++ stack.
+    string generateExpression(const Expr *expr)
     {
-        for (const auto &instr : instructions)
+        vector<const BinaryExpr *> spine;
+        while (expr->kind == N_BINOP)
         {
-            cout << instr << endl;
+            spine.push_back(static_cast<const BinaryExpr *>(expr));
+            expr = spine.back()->left;
+        }
+        string value = expr->kind == N_LITERAL ? string(static_cast<const LiteralExpr *>(expr)->text)
+                                               : string(static_cast<const VarExpr *>(expr)->name);
+        for (auto it = spine.rbegin(); it != spine.rend(); ++it)
+        {
+            string right = generateExpression((*it)->right);
+            string temp = newTemp();
+            addInstruction(temp + " = " + value + binaryOperator((*it)->op).text + right);
+            value = move(temp);
         }
+        return value;
     }
 };
 
+/*
+    Parser class:
+
+    A recursive-descent parser that checks the program against the symbol table and builds its AST in
+    an Arena; it emits no code itself. parseProgram returns the program as a block whose statements
+    are the top-level statements, and the tree stays valid for as long as the Arena and the source do.
+
+    Statements do not recurse: parseProgram keeps the statements that are still open (blocks, and if,
+    while and for statements waiting for their body) on an explicit stack on the heap, so nesting
+    depth is bounded only by memory. Only parenthesized sub-expressions recurse.
+*/
 class Parser
 {
 public:
     // Constructor
-    Parser(const vector<Token> &tokens, SymbolTable &symTable, IntermediateCodeGnerator &icg)
-        : tokens(tokens), pos(0), symTable(symTable), icg(icg) {}
+    Parser(Lexer &lexer, SymbolTable &symTable, Arena &arena)
+        : lexer(lexer), symTable(symTable), arena(arena) {}
     // here the private member of this class are being initalized with the arguments passed to this constructor
 
-    void parseProgram()
+    /*
+        parseProgram parses statements in a loop. A statement that needs a nested statement (a block, or the
+        body of an if, while or for) is opened: its node is built with the part parsed so far and pushed on
+        open. A statement that is complete is handed to the innermost open statement: a block appends it to
+        its list and goes on, while an if, while or for takes it as its body and is then complete itself, and
+        is handed on in turn. Closing '}' completes the innermost block.
+    */
+    BlockStmt *parseProgram()
     {
-        while (tokens[pos].type != T_EOF)
+        BlockStmt *program = arena.make<BlockStmt>(nullptr);
+        vector<OpenStatement> open;
+        open.push_back(OpenStatement{O_BLOCK, program, &program->first});
+
+        while (true)
         {
-            parseStatement();
+            Stmt *done = nullptr; // statement completed in this iteration, if any
+            OpenStatement &top = open.back();
+            if (open.size() == 1 && lexer.peek().type == T_EOF)
+            {
+                return program;
+            }
+            if (top.kind == O_BLOCK && open.size() > 1 && (lexer.peek().type == T_RBRACE || lexer.peek().type == T_EOF))
+            {
+                expect(T_RBRACE); // Closes the block; at the end of input this reports the missing '}'.
+                symTable.exitScope();
+                done = top.stmt;
+                open.pop_back();
+            }
+            else
+            {
+                done = parseStatement(open);
+            }
+
+            // Hand the completed statement outwards until a block takes it.
+            while (done)
+            {
+                OpenStatement &outer = open.back();
+                switch (outer.kind)
+                {
+                case O_BLOCK:
+                    *outer.link = done;
+                    outer.link = &done->next;
+                    done = nullptr;
+                    break;
+                case O_THEN:
+                {
+                    auto ifStmt = static_cast<IfStmt *>(outer.stmt);
+                    ifStmt->thenBranch = done;
+                    done = nullptr;
+                    if (lexer.peek().type == T_ELSE)
+                    { // If an else part exists, the if stays open for it.
+                        expect(T_ELSE);
+                        outer.kind = O_ELSE;
+                    }
+                    else
+                    {
+                        done = ifStmt;
+                        open.pop_back();
+                    }
+                    break;
+                }
+                case O_ELSE:
+                    static_cast<IfStmt *>(outer.stmt)->elseBranch = done;
+                    done = outer.stmt;
+                    open.pop_back();
+                    break;
+                case O_WHILE:
+                    static_cast<WhileStmt *>(outer.stmt)->body = done;
+                    done = outer.stmt;
+                    open.pop_back();
+                    break;
+                case O_FOR:
+                    static_cast<ForStmt *>(outer.stmt)->body = done;
+                    done = outer.stmt;
+                    open.pop_back();
+                    break;
+                }
+            }
         }
     }
 
 private:
-    vector<Token> tokens;
-    size_t pos;
+    Lexer &lexer; // tokens are pulled from the lexer as the parser needs them
     SymbolTable &symTable;
-    IntermediateCodeGnerator &icg;
+    Arena &arena; // every node of the tree is allocated here
 
-    void parseStatement()
+    // What an open statement is waiting for.
+    enum OpenKind : uint8_t
     {
-        if (tokens[pos].type == T_INT)
+        O_BLOCK, // the next statement of the block, or its '}'
+        O_THEN,  // the statement after if (...)
+        O_ELSE,  // the statement after else
+        O_WHILE, // the loop body
+        O_FOR    // the loop body
+    };
+
+    struct OpenStatement
+    {
+        OpenKind kind;
+        Stmt *stmt;
+        Stmt **link; // O_BLOCK: where the next statement of the block is stored
+    };
+
+    // Parses a complete statement and returns it, or parses the head of a statement that needs a nested
+    // statement, pushes it on open and returns null.
+    Stmt *parseStatement(vector<OpenStatement> &open)
+    {
+        if (lexer.peek().type == T_INT)
         {
-            parseDeclaration();
+            return parseDeclaration();
         }
-        else if (tokens[pos].type == T_ID)
+        else if (lexer.peek().type == T_ID)
         {
-            parseAssignment();
+            return parseAssignment();
         }
-        else if (tokens[pos].type == T_IF)
+        else if (lexer.peek().type == T_IF)
         {
-            parseIfStatement();
+            open.push_back(OpenStatement{O_THEN, parseIfHead(), nullptr});
         }
-        else if (tokens[pos].type == T_RETURN)
+        else if (lexer.peek().type == T_RETURN)
         {
-            parseReturnStatement();
+            return parseReturnStatement();
         }
-        else if (tokens[pos].type == T_LBRACE)
+        else if (lexer.peek().type == T_LBRACE)
         {
-            parseBlock();
+            expect(T_LBRACE); // Expect and consume the opening brace {.
+            symTable.enterScope(); // Declarations in the block are local to it.
+            BlockStmt *block = arena.make<BlockStmt>(nullptr);
+            open.push_back(OpenStatement{O_BLOCK, block, &block->first});
         }
-        else if (tokens[pos].type == T_FOR)
+        else if (lexer.peek().type == T_FOR)
         { // Added for-loop handling
-            parseForLoop();
+            open.push_back(OpenStatement{O_FOR, parseForHead(), nullptr});
         }
-        else if (tokens[pos].type == T_WHILE)
+        else if (lexer.peek().type == T_WHILE)
         { // Added while-loop handling
-            parseWhileLoop();
+            open.push_back(OpenStatement{O_WHILE, parseWhileHead(), nullptr});
         }
         else
         {
-            cout << "Syntax error: unexpected token '" << tokens[pos].value
-                 << "' at line " << tokens[pos].lineNumber << endl;
+            cout << "Syntax error: unexpected token '" << lexer.peek().value
+                 << "' at line " << lexer.peek().lineNumber << endl;
             exit(1);
         }
+        return nullptr;
     }
-    void parseForLoop()
+    // Parses for (init; condition; update) up to the body, which parseProgram fills in.
+    ForStmt *parseForHead()
     {
         expect(T_FOR);    // Consume the 'for' keyword.
         expect(T_LPAREN); // Expect and consume '('.
 
-        // Step 1: Initialization (e.g., int i = 0;)
-        parseAssignment(); // This assumes initialization is a regular assignment statement.
-
-        string loopStartLabel = "L" + to_string(icg.tempCount++); // Start of the loop.
-        icg.addInstruction(loopStartLabel + ":");
-
-        // Step 2: Condition (e.g., i < 10;)
-        string condition = parseExpression();   // Parse the loop condition.
-        string conditionResult = icg.newTemp(); // Temporary variable for condition result.
-        icg.addInstruction(conditionResult + " = " + condition);
+        // Step 1: Initialization (e.g., i = 0;)
+        AssignStmt *init = parseAssignment(); // This assumes initialization is a regular assignment statement.
 
-        string loopEndLabel = "L" + to_string(icg.tempCount++); // Label for exiting the loop.
-        icg.addInstruction("if " + conditionResult + " == 0 goto " + loopEndLabel);
+        // Step 2: Condition (e.g., i > 10;)
+        Expr *condition = parseExpression(); // Parse the loop condition.
+        expect(T_SEMICOLON);                 // Expect and consume ';'.
 
-        expect(T_SEMICOLON); // Expect and consume ';'.
-
-        // Step 3: Update expression (e.g., i = i + 1)
-        size_t updatePos = pos; // Save position to process the update later.
-        while (tokens[pos].type != T_RPAREN)
-            pos++;        // Skip to the end of the update part.
+        // Step 3: Update (e.g., i = (i + 1) * 2). It is parsed once, here, into a node that the code generator
+        // emits after the body. A ';' before the ')' is accepted too, as older sources write one.
+        AssignStmt *update = parseAssignmentClause();
+        if (lexer.peek().type == T_SEMICOLON)
+            lexer.next();
         expect(T_RPAREN); // Consume ')'.
 
-        // Step 4: Loop body
-        parseStatement(); // Parse the loop body.
-
-        // Step 5: Generate update expression and loop back to condition
-        string loopUpdateLabel = "L" + to_string(icg.tempCount++); // Label for update.
-        icg.addInstruction(loopUpdateLabel + ":");
-        pos = updatePos;   // Reset position to the update expression.
-        parseAssignment(); // Parse the update statement.
-
-        icg.addInstruction("goto " + loopStartLabel); // Jump back to the loop start.
-        icg.addInstruction(loopEndLabel + ":");       // Label for loop exit.
+        return arena.make<ForStmt>(init, condition, update, nullptr);
     }
-    void parseWhileLoop()
+    // Parses while (condition) up to the body, which parseProgram fills in.
+    WhileStmt *parseWhileHead()
     {
         expect(T_WHILE);  // Consume the 'while' keyword.
         expect(T_LPAREN); // Expect and consume '('.
 
-        // Step 1: Generate label for the start of the loop
-        string loopStartLabel = "L" + to_string(icg.tempCount++); // Start of the loop.
-        icg.addInstruction(loopStartLabel + ":");
-
-        // Step 2: Parse the condition
-        string condition = parseExpression();   // Parse the loop condition.
-        string conditionResult = icg.newTemp(); // Temporary variable for condition result.
-        icg.addInstruction(conditionResult + " = " + condition);
-
-        // Step 3: Generate label for loop exit
-        string loopEndLabel = "L" + to_string(icg.tempCount++); // Label for exiting the loop.
-        icg.addInstruction("if " + conditionResult + " == 0 goto " + loopEndLabel);
-
-        expect(T_RPAREN); // Expect and consume ')'.
-
-        // Step 4: Parse the loop body
-        parseStatement(); // Parse the loop body.
-
-        // Step 5: Jump back to the start of the loop
-        icg.addInstruction("goto " + loopStartLabel);
+        Expr *condition = parseExpression(); // Parse the loop condition.
+        expect(T_RPAREN);                    // Expect and consume ')'.
 
-        // Step 6: Generate the loop exit label
-        icg.addInstruction(loopEndLabel + ":");
+        return arena.make<WhileStmt>(condition, nullptr);
     }
 
     /*
      parseDeclaration handles the parsing of variable declarations.
      It expects the token type to be T_INT (for declaring an integer type variable),
      followed by an identifier (variable name), and a semicolon to terminate the statement.
-     It also registers the declared variable in the symbol table with type "int".
+     It also registers the declared variable in the symbol table with type int.
      Example:
-     int x;   // This will be parsed and the symbol table will store x with type "int".
+     int x;   // This will be parsed and the symbol table will store x with type int.
     */
-    void parseDeclaration()
+    Stmt *parseDeclaration()
     {
-        expect(T_INT);                               // Expect and consume the int keyword.
-        string varName = expectAndReturnValue(T_ID); // Expect and return the variable name (identifier).
-        symTable.declareVariable(varName, "int");    // Register the variable in the symbol table with type "int".
+        expect(T_INT);                             // Expect and consume the int keyword.
+        Token var = expectAndReturnToken(T_ID);    // Expect and return the variable name (identifier).
+        symTable.declareVariable(var.id, TYPE_INT); // Register the variable in the symbol table with type int.
         expect(T_SEMICOLON);                         // Expect the semicolon to end the statement.
+        return arena.make<DeclStmt>(var.value, var.id);
     }
 
     /*
      parseAssignment handles the parsing of variable assignments.
      It expects an identifier (variable name), an assignment operator =, followed by an expression,
      and a semicolon at the end of the statement.
-     It checks if the variable is declared in the symbol table, parses the expression, and generates intermediate code
-     for the assignment.
+     It checks if the variable is declared in the symbol table and builds an assignment node.
+     The part before the semicolon is parsed by parseAssignmentClause, which the for-loop update shares.
      Example:
-     x = 10;   -->  This will be parsed, checking if x is declared, then generating intermediate code like x = 10.
+     x = 10;   -->  This will be parsed, checking if x is declared, then building the node for x = 10.
     */
-    void parseAssignment()
+    AssignStmt *parseAssignment()
     {
-        string varName = expectAndReturnValue(T_ID);
-        symTable.getVariableType(varName); // Ensure the variable is declared in the symbol table.
-        expect(T_ASSIGN);
-        string expr = parseExpression();
-        icg.addInstruction(varName + " = " + expr); // Generate intermediate code for the assignment.
+        AssignStmt *assign = parseAssignmentClause();
         expect(T_SEMICOLON);
+        return assign;
+    }
+    AssignStmt *parseAssignmentClause()
+    {
+        Token var = expectAndReturnToken(T_ID);
+        symTable.getVariableType(var.id); // Ensure the variable is declared in the symbol table.
+        expect(T_ASSIGN);
+        Expr *expr = parseExpression();
+        return arena.make<AssignStmt>(var.value, var.id, expr);
     }
     /*
-         parseIfStatement handles the parsing of if statements.
+         parseIfHead handles the parsing of if statements up to their branches.
          It expects the keyword if, followed by an expression in parentheses that serves as the condition.
-         If the condition evaluates to true, it executes the statement inside the block. If an else part is present,
-         it executes the corresponding statement after the else keyword.
-         Intermediate code for the if statement is generated, including labels for conditional jumps.
+         parseProgram then fills in the statement to run when it holds and, if the keyword else follows it,
+         the statement to run otherwise.
          Example:
-         if(5 > 3) { x = 20; }  --> This will generate intermediate code for the condition check and jump instructions.
+         if(5 > 3) { x = 20; }  --> This will build an if node with the condition, and the block as its branch.
     */
-    void parseIfStatement()
+    IfStmt *parseIfHead()
     {
         expect(T_IF);
-        expect(T_LPAREN);                // Expect and consume the opening parenthesis for the condition.
-        string cond = parseExpression(); // Parse the condition expression inside the parentheses.
+        expect(T_LPAREN);               // Expect and consume the opening parenthesis for the condition.
+        Expr *cond = parseExpression(); // Parse the condition expression inside the parentheses.
         expect(T_RPAREN);
-
-        string temp = icg.newTemp();             // Generate a new temporary variable for the condition result.
-        icg.addInstruction(temp + " = " + cond); // Generate intermediate code for storing the condition result.
-
-        icg.addInstruction("if " + temp + " goto L1"); // Jump to label L1 if condition is true.
-        icg.addInstruction("goto L2");                 // Otherwise, jump to label L2.
-        icg.addInstruction("L1:");                     // Otherwise, jump to label L2.
-
-        parseStatement();
-
-        if (tokens[pos].type == T_ELSE)
-        { // If an else part exists, handle it.
-            icg.addInstruction("goto L3");
-            icg.addInstruction("L2:");
-            expect(T_ELSE);
-            parseStatement(); // Parse the statement inside the else block.
-            icg.addInstruction("L3:");
-        }
-        else
-        {
-            icg.addInstruction("L2:");
-        }
+        return arena.make<IfStmt>(cond, nullptr, nullptr);
     }
     /*
         parseReturnStatement handles the parsing of return statements.
         It expects the keyword return, followed by an expression to return, and a semicolon to terminate the statement.
-        It generates intermediate code to represent the return of the expression.
         Example:
-        return x + 5;   -->  This will generate intermediate code like return x + 5.
+        return x + 5;   -->  This will build a return node for the expression x + 5.
     */
-    void parseReturnStatement()
+    Stmt *parseReturnStatement()
     {
         expect(T_RETURN);
-        string expr = parseExpression();
-        icg.addInstruction("return " + expr); // Generate intermediate code for the return statement.
+        Expr *expr = parseExpression();
         expect(T_SEMICOLON);
+        return arena.make<ReturnStmt>(expr);
     }
     /*
-        parseBlock handles the parsing of block statements, which are enclosed in curly braces { }.
-        It parses the statements inside the block recursively until it reaches the closing brace.
-        Example:
-        { x = 10; y = 20; }   -->  This will parse each statement inside the block.
-    */
-    void parseBlock()
-    {
-
-        expect(T_LBRACE); // Expect and consume the opening brace {.
-        while (tokens[pos].type != T_RBRACE && tokens[pos].type != T_EOF)
-        {
-            parseStatement(); // Parse the statements inside the block.
-        }
-        expect(T_RBRACE);
-    }
-    /*
-        parseExpression handles the parsing of expressions involving addition, subtraction, or comparison operations.
-        It first parses a term, then processes addition (+) or subtraction (-) operators if present, generating
-        intermediate code for the operations.
-        Example:
-        5 + 3 - 2;  -->  This will generate intermediate code like t0 = 5 + 3 and t1 = t0 - 2.
-    */
-    string parseExpression()
-    {
-        string term = parseTerm();
-        while (tokens[pos].type == T_PLUS || tokens[pos].type == T_MINUS)
-        {
-            TokenType op = tokens[pos++].type;
-            string nextTerm = parseTerm();                                                       // Parse the next term in the expression.
-            string temp = icg.newTemp();                                                         // Generate a temporary variable for the result
-            icg.addInstruction(temp + " = " + term + (op == T_PLUS ? " + " : " - ") + nextTerm); // Intermediate code for operation
-            term = temp;
-        }
-        if (tokens[pos].type == T_GT)
-        {
-            pos++;
-            string nextExpr = parseExpression();                        // Parse the next expression for the comparison.
-            string temp = icg.newTemp();                                // Generate a temporary variable for the result.
-            icg.addInstruction(temp + " = " + term + " > " + nextExpr); // Intermediate code for the comparison.
-            term = temp;
-        }
-        return term;
-    }
-    /*
-        parseTerm handles the parsing of terms involving multiplication or division operations.
-        It first parses a factor, then processes multiplication (*) or division (/) operators if present,
-        generating intermediate code for the operations.
+        parseExpression parses a binary expression by precedence climbing over OPERATOR_TABLE.
+        It parses an operand, then keeps folding in operators whose precedence is at least minPrecedence;
+        the right operand of each is parsed with minPrecedence one higher, so it only takes operators that
+        bind tighter. Operators of equal precedence are folded by the loop, which makes them left-associative
+        and costs no recursion, however long the chain is; recursion depth is bounded by the number of
+        precedence levels (plus one level per pair of parentheses).
         Example:
-        5 * 3 / 2;   This will generate intermediate code like t0 = 5 * 3 and t1 = t0 / 2.
+        a > b > c;        -->  This will build (a > b) > c.
+        5 + 3 * 2 - 1;    -->  This will build (5 + (3 * 2)) - 1.
     */
-    string parseTerm()
+    Expr *parseExpression(int minPrecedence = 1)
     {
-        string factor = parseFactor();
-        while (tokens[pos].type == T_MUL || tokens[pos].type == T_DIV)
+        Expr *left = parseFactor();
+        while (true)
         {
-            TokenType op = tokens[pos++].type;
-            string nextFactor = parseFactor();
-            string temp = icg.newTemp();                                                            // Generate a temporary variable for the result.
-            icg.addInstruction(temp + " = " + factor + (op == T_MUL ? " * " : " / ") + nextFactor); // Intermediate code for operation.
-            factor = temp;                                                                          // Update the factor to be the temporary result.
+            const BinaryOperator &op = binaryOperator(lexer.peek().type);
+            if (op.precedence == 0 || op.precedence < minPrecedence)
+                break;
+            lexer.next();
+            Expr *right = parseExpression(op.precedence + 1);
+            left = arena.make<BinaryExpr>(op.type, left, right);
         }
-        return factor;
+        return left;
     }
     /*
         parseFactor handles the parsing of factors in expressions, which can be either numeric literals, identifiers
         (variables), or expressions inside parentheses (for sub-expressions).
         Example:
-        5;          -->  This will return the number "5".
-        x;          -->  This will return the identifier "x".
-        (5 + 3);    --> This will return the sub-expression "5 + 3".
+        5;          -->  This will return a literal node for "5".
+        x;          -->  This will return a variable node for "x".
+        (5 + 3);    --> This will return the node of the sub-expression "5 + 3".
     */
-    string parseFactor()
+    Expr *parseFactor()
     {
-        if (tokens[pos].type == T_NUM)
+        if (lexer.peek().type == T_NUM)
         {
-            return tokens[pos++].value;
+            return arena.make<LiteralExpr>(lexer.next().value);
         }
-        else if (tokens[pos].type == T_ID)
+        else if (lexer.peek().type == T_ID)
         {
-            return tokens[pos++].value;
+            Token var = lexer.next();
+            return arena.make<VarExpr>(var.value, var.id);
         }
-        else if (tokens[pos].type == T_LPAREN)
+        else if (lexer.peek().type == T_LPAREN)
         {
             expect(T_LPAREN);
-            string expr = parseExpression();
+            Expr *expr = parseExpression();
             expect(T_RPAREN);
             return expr;
         }
         else
         {
-            cout << "Syntax error: unexpected token '" << tokens[pos].value << "' at line " << tokens[pos].lineNumber << endl;
+            cout << "Syntax error: unexpected token '" << lexer.peek().value << "' at line " << lexer.peek().lineNumber << endl;
             exit(1);
         }
     }
@@ -591,39 +1860,186 @@ private:
     */
     void expect(TokenType type)
     {
-        if (tokens[pos].type != type)
+        if (lexer.peek().type != type)
         {
-            cout << "Syntax error: expected '" << type << "' at line " << tokens[pos].lineNumber << endl;
+            cout << "Syntax error: expected '" << type << "' at line " << lexer.peek().lineNumber << endl;
             exit(1);
         }
-        pos++;
+        lexer.next();
     }
     /*
     Explanation:
     - The expect function ensures that the parser encounters the correct tokens in the expected order.
     - It's mainly used for non-value-based tokens, such as keywords, operators, and delimiters (e.g., semicolons).
     - If the parser encounters an unexpected token, it halts the process by printing an error message, indicating where the error occurred (line number) and what was expected.
-    - The pos++ advances to the next token after confirming the expected token is present.
+    - The lexer.next() call advances to the next token after confirming the expected token is present.
 
     Use Case:
     - This function is helpful when checking for the correct syntax or structure in a language's grammar, ensuring the parser processes the tokens in the correct order.
     */
-    string expectAndReturnValue(TokenType type)
+    Token expectAndReturnToken(TokenType type)
     {
-        string value = tokens[pos].value;
+        Token token = lexer.peek();
         expect(type);
-        return value;
+        return token;
     }
 
     /*
         Why both functions are needed:
         - The expect function is useful when you are only concerned with ensuring the correct token type without needing its value.
         - For example, ensuring a semicolon ; or a keyword if is present in the source code.
-        - The expectAndReturnValue function is needed when the parser not only needs to check for a specific token but also needs to use the value of that token in the next stages of compilation or interpretation.
+        - The expectAndReturnToken function is needed when the parser not only needs to check for a specific token but also needs to use the token (its interned id or its text) in the next stages of compilation or interpretation.
         - For example, extracting the name of a variable (T_ID) or the value of a constant (T_NUMBER) to process it in a symbol table or during expression evaluation.
     */
 };
 
+// LALR(1) tables generated by lalrgen (lalrgen.cpp) from cc.grammar, for LalrParser.
+// Regenerate with: lalrgen cc.grammar > cc_lalr.h
+#include "cc_lalr.h"
+
+/*
+    LalrParser class:
+
+    A table-driven shift-reduce parser for the same language as Parser, an alternative to it that
+    builds the same AST (so IntermediateCodeGnerator gives the same TAC). The state and value stacks
+    are vectors, so, like Parser, it has no recursion and nesting depth is bounded only by memory.
+
+    Each step looks up LALR_ACTION for the current state and the next token: a shift pushes the token,
+    a reduce pops the right side of a rule, runs the rule's action on the popped values and pushes the
+    result in the state LALR_GOTO gives. Actions do what the matching Parser code does, including the
+    symbol-table checks; an assignment target is checked when the assignment is reduced, that is after
+    its expression has been read rather than before.
+
+    Compile with -DCC_LALR_PARSER to have main use it instead of Parser.
+*/
+class LalrParser
+{
+public:
+    LalrParser(Lexer &lexer, SymbolTable &symTable, Arena &arena)
+        : lexer(lexer), symTable(symTable), arena(arena) {}
+
+    BlockStmt *parseProgram()
+    {
+        vector<int16_t> states{0};
+        vector<Value> values(1);
+        while (true)
+        {
+            int action = LALR_ACTION[states.back()][lexer.peek().type];
+            if (action > 0)
+            {
+                if (lexer.peek().type == T_LBRACE)
+                    symTable.enterScope(); // left again when the block is reduced
+                states.push_back(static_cast<int16_t>(action - 1));
+                values.push_back(Value{lexer.next()});
+            }
+            else if (action < 0)
+            {
+                int rule = -action - 1;
+                if (rule == 0)
+                {
+                    return static_cast<BlockStmt *>(values.back().stmt);
+                }
+                size_t length = LALR_RULE_LENGTH[rule];
+                Value result = reduce(LALR_RULE_ACTION[rule], values.data() + values.size() - length);
+                states.resize(states.size() - length);
+                values.resize(values.size() - length);
+                states.push_back(LALR_GOTO[states.back()][LALR_RULE_LHS[rule]]);
+                values.push_back(result);
+            }
+            else
+            {
+                cout << "Syntax error: unexpected token '" << lexer.peek().value
+                     << "' at line " << lexer.peek().lineNumber << endl;
+                exit(1);
+            }
+        }
+    }
+
+private:
+    Lexer &lexer;
+    SymbolTable &symTable;
+    Arena &arena; // every node of the tree is allocated here
+
+    // Semantic value of a grammar symbol: the token for a terminal; for a nonterminal, its node, or
+    // for a statement list its first statement (stmt) and last one (last), so appending is O(1).
+    struct Value
+    {
+        Token token;
+        Stmt *stmt = nullptr;
+        Stmt *last = nullptr;
+        Expr *expr = nullptr;
+    };
+
+    // Runs the action of a rule; v points at the values of its right side.
+    Value reduce(LalrAction action, const Value *v)
+    {
+        Value result;
+        switch (action)
+        {
+        case A_PROGRAM:
+            result.stmt = arena.make<BlockStmt>(v[0].stmt);
+            break;
+        case A_EMPTY_LIST:
+        case A_NONE:
+            break;
+        case A_APPEND:
+            result = v[0];
+            if (result.last)
+                result.last->next = v[1].stmt;
+            else
+                result.stmt = v[1].stmt;
+            result.last = v[1].stmt;
+            break;
+        case A_DECL:
+            symTable.declareVariable(v[1].token.id, TYPE_INT); // Register the variable in the symbol table with type int.
+            result.stmt = arena.make<DeclStmt>(v[1].token.value, v[1].token.id);
+            break;
+        case A_FIRST:
+            result = v[0];
+            break;
+        case A_SECOND:
+            result = v[1];
+            break;
+        case A_IF:
+            result.stmt = arena.make<IfStmt>(v[2].expr, v[4].stmt, nullptr);
+            break;
+        case A_IF_ELSE:
+            result.stmt = arena.make<IfStmt>(v[2].expr, v[4].stmt, v[6].stmt);
+            break;
+        case A_WHILE:
+            result.stmt = arena.make<WhileStmt>(v[2].expr, v[4].stmt);
+            break;
+        case A_FOR:
+            result.stmt = arena.make<ForStmt>(static_cast<AssignStmt *>(v[2].stmt), v[4].expr,
+                                              static_cast<AssignStmt *>(v[6].stmt), v[9].stmt);
+            break;
+        case A_RETURN:
+            result.stmt = arena.make<ReturnStmt>(v[1].expr);
+            break;
+        case A_BLOCK:
+            symTable.exitScope();
+            result.stmt = arena.make<BlockStmt>(v[1].stmt);
+            break;
+        case A_ASSIGN:
+            symTable.getVariableType(v[0].token.id); // Ensure the variable is declared in the symbol table.
+            result.stmt = arena.make<AssignStmt>(v[0].token.value, v[0].token.id, v[2].expr);
+            break;
+        case A_BINARY:
+            result.expr = arena.make<BinaryExpr>(v[1].token.type, v[0].expr, v[2].expr);
+            break;
+        case A_LITERAL:
+            result.expr = arena.make<LiteralExpr>(v[0].token.value);
+            break;
+        case A_VAR:
+            result.expr = arena.make<VarExpr>(v[0].token.value, v[0].token.id);
+            break;
+        default: // A_ACCEPT is handled by parseProgram
+            break;
+        }
+        return result;
+    }
+};
+
 // class AssemblyGenerator
 // {
 // public:
@@ -1076,17 +2492,45 @@ class AssemblyCodeGenerator
 private:
     vector<string> assemblyCode;
     int labelCounter;
-    unordered_map<string, string> variableRegisterMap;
+    const StringInterner &names;         // the Lexer's; source variables are looked up by the ids they got there
+    vector<int> registerOf;              // register number per source identifier id, -1 while unassigned
+    vector<int> tempRegisterOf;          // register number per TAC temporary tN, indexed by N
+    unordered_map<string, int> otherRegisterOf; // codegen's own operands: temp_<literal>, tempResult
     int registerCounter = 0;
 
-    // Allocate a register for variables and arrays
+    static int &assign(vector<int> &table, size_t index)
+    {
+        if (index >= table.size())
+        {
+            table.resize(index + 1, -1);
+        }
+        return table[index];
+    }
+
+    // Allocate a register for variables and arrays. Source identifiers are found in the Lexer's
+    // interner without adding to it, TAC temporaries by their number, and the few names codegen makes
+    // up in a small map, so registerOf stays as dense as the source's identifiers.
     string allocateRegister(const string &var)
     {
-        if (variableRegisterMap.find(var) == variableRegisterMap.end())
+        int *slot;
+        uint32_t id = names.find(var);
+        if (id != StringInterner::NOT_INTERNED)
+        {
+            slot = &assign(registerOf, id);
+        }
+        else if (var.size() > 1 && var[0] == 't' && all_of(var.begin() + 1, var.end(), ::isdigit))
+        {
+            slot = &assign(tempRegisterOf, stoul(var.substr(1)));
+        }
+        else
+        {
+            slot = &otherRegisterOf.try_emplace(var, -1).first->second;
+        }
+        if (*slot < 0)
         {
-            variableRegisterMap[var] = "r" + to_string(registerCounter++);
+            *slot = registerCounter++;
         }
-        return variableRegisterMap[var];
+        return "r" + to_string(*slot);
     }
 
     // Add assembly instruction to the list
@@ -1224,7 +2668,7 @@ private:
     }
 
 public:
-    AssemblyCodeGenerator() : labelCounter(0) {}
+    AssemblyCodeGenerator(const StringInterner &names) : labelCounter(0), names(names) {}
 
     // Generate the assembly code from the intermediate code
     void generateAssembly(const vector<string>& intermediateCode)
@@ -1280,7 +2724,9 @@ public:
 };
 
 
-int main()
+// With a file argument the file is compiled instead of the demo program (tests/run_tests.sh uses this),
+// and only its TAC and assembly are printed.
+int main(int argc, char *argv[])
 {
     string src = R"(
     int x;
@@ -1297,20 +2743,41 @@ int main()
         x = x +1;
     }
     )";
-    Lexer lexer(src);
-    vector<Token> tokens = lexer.tokenize();
+    if (argc > 1)
+    {
+        ifstream file(argv[1]);
+        if (!file)
+        {
+            cout << "Error opening file: " << argv[1] << endl;
+            return 1;
+        }
+        stringstream contents;
+        contents << file.rdbuf();
+        src = contents.str();
+    }
+    StringInterner names;
+    Lexer lexer(src, names);
+
+    SymbolTable symTable(names);
+    Arena arena; // owns the AST; the whole tree is freed with it
+#ifdef CC_LALR_PARSER
+    LalrParser parser(lexer, symTable, arena);
+#else
+    Parser parser(lexer, symTable, arena);
+#endif
+    BlockStmt *program = parser.parseProgram();
 
-    SymbolTable symTable;
     IntermediateCodeGnerator icg;
-    Parser parser(tokens, symTable, icg);
-
-    parser.parseProgram();
+    icg.generate(program);
     icg.printInstructions();
 
-    AssemblyCodeGenerator acg;
+    AssemblyCodeGenerator acg(names);
     acg.generateAssembly(icg.instructions);
     acg.printAssemblyCode();
-
+    if (argc > 1)
+    {
+        return 0;
+    }
 
 
     /* Section for Arrays feature */
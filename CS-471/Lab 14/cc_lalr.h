@@ -0,0 +1,242 @@
+// Generated by lalrgen from cc.grammar; do not edit, change the grammar and regenerate.
+// LALR(1) tables with 70 states, 32 rules and 1 shift/reduce conflicts resolved as shift.
+// TokenType must be declared before this header is included.
+#include <cstdint>
+
+static_assert(T_INT == 0, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_ID == 1, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_NUM == 2, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_IF == 3, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_ELSE == 4, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_RETURN == 5, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_FOR == 6, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_WHILE == 7, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_ASSIGN == 8, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_PLUS == 9, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_MINUS == 10, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_MUL == 11, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_DIV == 12, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_LPAREN == 13, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_RPAREN == 14, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_LBRACE == 15, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_RBRACE == 16, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_SEMICOLON == 17, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_GT == 18, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_LT == 19, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_EQ == 20, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_NEQ == 21, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_LTE == 22, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_GTE == 23, "TokenType does not match %tokens in cc.grammar");
+static_assert(T_EOF == 24, "TokenType does not match %tokens in cc.grammar");
+
+const int LALR_STATES = 70;
+const int LALR_TOKENS = 25;
+const int LALR_NONTERMINALS = 11;
+const int LALR_RULES = 32;
+
+enum LalrAction : uint8_t
+{
+    A_ACCEPT,
+    A_PROGRAM,
+    A_EMPTY_LIST,
+    A_APPEND,
+    A_DECL,
+    A_FIRST,
+    A_IF,
+    A_IF_ELSE,
+    A_WHILE,
+    A_FOR,
+    A_RETURN,
+    A_BLOCK,
+    A_NONE,
+    A_ASSIGN,
+    A_BINARY,
+    A_LITERAL,
+    A_VAR,
+    A_SECOND,
+};
+
+// 0: syntax error, s > 0: shift and go to state s - 1, r < 0: reduce by rule -r - 1 (rule 0 accepts).
+const int16_t LALR_ACTION[LALR_STATES][LALR_TOKENS] = {
+    {-3,-3,0,-3,0,-3,-3,-3,0,0,0,0,0,0,0,-3,0,0,0,0,0,0,0,0,-3},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,-1},
+    {4,5,0,6,0,7,8,9,0,0,0,0,0,0,0,10,0,0,0,0,0,0,0,0,-2},
+    {0,13,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+    {0,0,0,0,0,0,0,0,14,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,15,0,0,0,0,0,0,0,0,0,0,0},
+    {0,16,17,0,0,0,0,0,0,0,0,0,0,18,0,0,0,0,0,0,0,0,0,0,0},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,24,0,0,0,0,0,0,0,0,0,0,0},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,25,0,0,0,0,0,0,0,0,0,0,0},
+    {-3,-3,0,-3,0,-3,-3,-3,0,0,0,0,0,0,0,-3,-3,0,0,0,0,0,0,0,0},
+    {-4,-4,0,-4,0,-4,-4,-4,0,0,0,0,0,0,0,-4,-4,0,0,0,0,0,0,0,-4},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,27,0,0,0,0,0,0,0},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,28,0,0,0,0,0,0,0},
+    {0,16,17,0,0,0,0,0,0,0,0,0,0,18,0,0,0,0,0,0,0,0,0,0,0},
+    {0,16,17,0,0,0,0,0,0,0,0,0,0,18,0,0,0,0,0,0,0,0,0,0,0},
+    {0,0,0,0,0,0,0,0,0,-31,-31,-31,-31,0,-31,0,0,-31,-31,-31,-31,-31,-31,-31,0},
+    {0,0,0,0,0,0,0,0,0,-30,-30,-30,-30,0,-30,0,0,-30,-30,-30,-30,-30,-30,-30,0},
+    {0,16,17,0,0,0,0,0,0,0,0,0,0,18,0,0,0,0,0,0,0,0,0,0,0},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,32,0,0,33,34,0,0,0},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,-18,0,0,-18,35,36,-18,-18,37,38,0},
+    {0,0,0,0,0,0,0,0,0,39,40,0,0,0,-23,0,0,-23,-23,-23,-23,-23,-23,-23,0},
+    {0,0,0,0,0,0,0,0,0,-26,-26,41,42,0,-26,0,0,-26,-26,-26,-26,-26,-26,-26,0},
+    {0,0,0,0,0,0,0,0,0,-29,-29,-29,-29,0,-29,0,0,-29,-29,-29,-29,-29,-29,-29,0},
+    {0,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+    {0,16,17,0,0,0,0,0,0,0,0,0,0,18,0,0,0,0,0,0,0,0,0,0,0},
+    {4,5,0,6,0,7,8,9,0,0,0,0,0,0,0,10,45,0,0,0,0,0,0,0,0},
+    {-6,-6,0,-6,-6,-6,-6,-6,0,0,0,0,0,0,0,-6,-6,0,0,0,0,0,0,0,-6},
+    {-5,-5,0,-5,-5,-5,-5,-5,0,0,0,0,0,0,0,-5,-5,0,0,0,0,0,0,0,-5},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,-15,0,0,-15,0,0,33,34,0,0,0},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,0,0,0,0,0,33,34,0,0,0},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,47,0,0,0,0,0,33,34,0,0,0},
+    {-11,-11,0,-11,-11,-11,-11,-11,0,0,0,0,0,0,0,-11,-11,0,0,0,0,0,0,0,-11},
+    {0,16,17,0,0,0,0,0,0,0,0,0,0,18,0,0,0,0,0,0,0,0,0,0,0},
+    {0,16,17,0,0,0,0,0,0,0,0,0,0,18,0,0,0,0,0,0,0,0,0,0,0},
+    {0,16,17,0,0,0,0,0,0,0,0,0,0,18,0,0,0,0,0,0,0,0,0,0,0},
+    {0,16,17,0,0,0,0,0,0,0,0,0,0,18,0,0,0,0,0,0,0,0,0,0,0},
+    {0,16,17,0,0,0,0,0,0,0,0,0,0,18,0,0,0,0,0,0,0,0,0,0,0},
+    {0,16,17,0,0,0,0,0,0,0,0,0,0,18,0,0,0,0,0,0,0,0,0,0,0},
+    {0,16,17,0,0,0,0,0,0,0,0,0,0,18,0,0,0,0,0,0,0,0,0,0,0},
+    {0,16,17,0,0,0,0,0,0,0,0,0,0,18,0,0,0,0,0,0,0,0,0,0,0},
+    {0,16,17,0,0,0,0,0,0,0,0,0,0,18,0,0,0,0,0,0,0,0,0,0,0},
+    {0,16,17,0,0,0,0,0,0,0,0,0,0,18,0,0,0,0,0,0,0,0,0,0,0},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,58,0,0,0,0,0,0,0},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,59,0,0,0,0,0,33,34,0,0,0},
+    {-12,-12,0,-12,-12,-12,-12,-12,0,0,0,0,0,0,0,-12,-12,0,0,0,0,0,0,0,-12},
+    {4,5,0,6,0,7,8,9,0,0,0,0,0,0,0,10,0,0,0,0,0,0,0,0,0},
+    {0,0,0,0,0,0,0,0,0,-32,-32,-32,-32,0,-32,0,0,-32,-32,-32,-32,-32,-32,-32,0},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,-16,0,0,-16,35,36,-16,-16,37,38,0},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,-17,0,0,-17,35,36,-17,-17,37,38,0},
+    {0,0,0,0,0,0,0,0,0,39,40,0,0,0,-20,0,0,-20,-20,-20,-20,-20,-20,-20,0},
+    {0,0,0,0,0,0,0,0,0,39,40,0,0,0,-19,0,0,-19,-19,-19,-19,-19,-19,-19,0},
+    {0,0,0,0,0,0,0,0,0,39,40,0,0,0,-21,0,0,-21,-21,-21,-21,-21,-21,-21,0},
+    {0,0,0,0,0,0,0,0,0,39,40,0,0,0,-22,0,0,-22,-22,-22,-22,-22,-22,-22,0},
+    {0,0,0,0,0,0,0,0,0,-24,-24,41,42,0,-24,0,0,-24,-24,-24,-24,-24,-24,-24,0},
+    {0,0,0,0,0,0,0,0,0,-25,-25,41,42,0,-25,0,0,-25,-25,-25,-25,-25,-25,-25,0},
+    {0,0,0,0,0,0,0,0,0,-27,-27,-27,-27,0,-27,0,0,-27,-27,-27,-27,-27,-27,-27,0},
+    {0,0,0,0,0,0,0,0,0,-28,-28,-28,-28,0,-28,0,0,-28,-28,-28,-28,-28,-28,-28,0},
+    {0,16,17,0,0,0,0,0,0,0,0,0,0,18,0,0,0,0,0,0,0,0,0,0,0},
+    {4,5,0,6,0,7,8,9,0,0,0,0,0,0,0,10,0,0,0,0,0,0,0,0,0},
+    {-7,-7,0,-7,63,-7,-7,-7,0,0,0,0,0,0,0,-7,-7,0,0,0,0,0,0,0,-7},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,64,0,0,33,34,0,0,0},
+    {-9,-9,0,-9,-9,-9,-9,-9,0,0,0,0,0,0,0,-9,-9,0,0,0,0,0,0,0,-9},
+    {4,5,0,6,0,7,8,9,0,0,0,0,0,0,0,10,0,0,0,0,0,0,0,0,0},
+    {0,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+    {-8,-8,0,-8,-8,-8,-8,-8,0,0,0,0,0,0,0,-8,-8,0,0,0,0,0,0,0,-8},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,-13,0,0,67,0,0,0,0,0,0,0},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,-14,0,0,0,0,0,0,0,0,0,0},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,69,0,0,0,0,0,0,0,0,0,0},
+    {4,5,0,6,0,7,8,9,0,0,0,0,0,0,0,10,0,0,0,0,0,0,0,0,0},
+    {-10,-10,0,-10,-10,-10,-10,-10,0,0,0,0,0,0,0,-10,-10,0,0,0,0,0,0,0,-10},
+};
+
+// State after reducing to a nonterminal, -1 where no rule leads.
+const int16_t LALR_GOTO[LALR_STATES][LALR_NONTERMINALS] = {
+    {-1,1,2,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,10,11,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,18,-1,19,20,21,22},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,25,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,28,-1,19,20,21,22},
+    {-1,-1,-1,-1,-1,29,-1,19,20,21,22},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,30,-1,19,20,21,22},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,42,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,43,-1,19,20,21,22},
+    {-1,-1,-1,10,11,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,47,20,21,22},
+    {-1,-1,-1,-1,-1,-1,-1,48,20,21,22},
+    {-1,-1,-1,-1,-1,-1,-1,-1,49,21,22},
+    {-1,-1,-1,-1,-1,-1,-1,-1,50,21,22},
+    {-1,-1,-1,-1,-1,-1,-1,-1,51,21,22},
+    {-1,-1,-1,-1,-1,-1,-1,-1,52,21,22},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,53,22},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,54,22},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,55},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,56},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,59,11,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,60,-1,19,20,21,22},
+    {-1,-1,-1,61,11,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,64,11,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,65,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,67,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,69,11,-1,-1,-1,-1,-1,-1},
+    {-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1},
+};
+
+// Rules:
+//  0: $accept : program = ACCEPT
+//  1: program : statements = PROGRAM
+//  2: statements : = EMPTY_LIST
+//  3: statements : statements statement = APPEND
+//  4: statement : T_INT T_ID T_SEMICOLON = DECL
+//  5: statement : assignment T_SEMICOLON = FIRST
+//  6: statement : T_IF T_LPAREN expression T_RPAREN statement = IF
+//  7: statement : T_IF T_LPAREN expression T_RPAREN statement T_ELSE statement = IF_ELSE
+//  8: statement : T_WHILE T_LPAREN expression T_RPAREN statement = WHILE
+//  9: statement : T_FOR T_LPAREN assignment T_SEMICOLON expression T_SEMICOLON assignment optionalSemicolon T_RPAREN statement = FOR
+//  10: statement : T_RETURN expression T_SEMICOLON = RETURN
+//  11: statement : T_LBRACE statements T_RBRACE = BLOCK
+//  12: optionalSemicolon : = NONE
+//  13: optionalSemicolon : T_SEMICOLON = NONE
+//  14: assignment : T_ID T_ASSIGN expression = ASSIGN
+//  15: expression : expression T_EQ relation = BINARY
+//  16: expression : expression T_NEQ relation = BINARY
+//  17: expression : relation = FIRST
+//  18: relation : relation T_LT sum = BINARY
+//  19: relation : relation T_GT sum = BINARY
+//  20: relation : relation T_LTE sum = BINARY
+//  21: relation : relation T_GTE sum = BINARY
+//  22: relation : sum = FIRST
+//  23: sum : sum T_PLUS term = BINARY
+//  24: sum : sum T_MINUS term = BINARY
+//  25: sum : term = FIRST
+//  26: term : term T_MUL factor = BINARY
+//  27: term : term T_DIV factor = BINARY
+//  28: term : factor = FIRST
+//  29: factor : T_NUM = LITERAL
+//  30: factor : T_ID = VAR
+//  31: factor : T_LPAREN expression T_RPAREN = SECOND
+const uint8_t LALR_RULE_LHS[LALR_RULES] = {0, 1, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 6, 6, 4, 5, 5, 5, 7, 7, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10, 10};
+const uint8_t LALR_RULE_LENGTH[LALR_RULES] = {1, 1, 0, 2, 3, 2, 5, 7, 5, 10, 3, 3, 0, 1, 3, 3, 3, 1, 3, 3, 3, 3, 1, 3, 3, 1, 3, 3, 1, 1, 1, 3};
+const LalrAction LALR_RULE_ACTION[LALR_RULES] = {A_ACCEPT, A_PROGRAM, A_EMPTY_LIST, A_APPEND, A_DECL, A_FIRST, A_IF, A_IF_ELSE, A_WHILE, A_FOR, A_RETURN, A_BLOCK, A_NONE, A_NONE, A_ASSIGN, A_BINARY, A_BINARY, A_FIRST, A_BINARY, A_BINARY, A_BINARY, A_BINARY, A_FIRST, A_BINARY, A_BINARY, A_FIRST, A_BINARY, A_BINARY, A_FIRST, A_LITERAL, A_VAR, A_SECOND};
@@ -386,7 +386,7 @@ public:
     }
 
 private:
-    vector<Token> tokens;
+    const vector<Token> &tokens; // borrowed, not copied: the caller keeps the vector alive while parsing
     size_t pos;
     SymbolTable &symTable;
     IntermediateCodeGnerator &icg;
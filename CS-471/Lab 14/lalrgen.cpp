@@ -0,0 +1,507 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <bitset>
+#include <map>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+/*
+    lalrgen: LALR(1) parser generator for the table-driven parser in cc.cpp.
+
+    It reads a grammar and prints a C++ header with the parse tables for it:
+
+        lalrgen cc.grammar > cc_lalr.h
+
+    Grammar: blank lines and lines starting with # are ignored.
+    - "%tokens T_A T_B ...": every TokenType, in declaration order (the tables are indexed by TokenType).
+    - "%end T_EOF": the token that ends the input.
+    - "lhs : SYM SYM ... = ACTION": one rule per line. Symbols that are listed in %tokens are terminals,
+      all others are nonterminals, and every nonterminal needs at least one rule. An empty right side
+      is written "lhs : = ACTION". ACTION names what the parser does when it reduces by the rule; rules
+      may share an action. The left side of the first rule is the start symbol.
+
+    The generated header has
+    - LalrAction: one enumerator A_<ACTION> per action, in order of first use.
+    - LALR_ACTION[state][token]: 0 is a syntax error, s > 0 shifts the token and goes to state s - 1,
+      r < 0 reduces by rule -r - 1. Reducing by rule 0 ($accept : start) accepts the input.
+    - LALR_GOTO[state][nonterminal]: the state after reducing to the nonterminal, -1 where unused.
+    - LALR_RULE_LHS, LALR_RULE_LENGTH, LALR_RULE_ACTION: the left side, the number of right-side
+      symbols and the action of each rule.
+    TokenType must be declared before the header is included.
+
+    Steps: LR(0) automaton -> LALR(1) lookaheads, propagated through the LR(0) states until nothing
+    changes -> tables. A shift/reduce conflict is resolved as a shift and reported (the dangling else
+    is one); a reduce/reduce conflict is an error.
+*/
+
+const size_t MAX_TOKENS = 256;
+typedef bitset<MAX_TOKENS> TokenSet;
+
+struct Rule
+{
+    int lhs;         // nonterminal index
+    vector<int> rhs; // symbols: a token index, or MAX_TOKENS + nonterminal index
+    int action;
+};
+
+struct Item
+{
+    int rule;
+    int dot;
+    bool operator<(const Item &other) const { return rule != other.rule ? rule < other.rule : dot < other.dot; }
+    bool operator==(const Item &other) const { return rule == other.rule && dot == other.dot; }
+};
+
+class Grammar
+{
+public:
+    vector<string> tokens;
+    vector<string> nonterminals; // nonterminal 0 is $accept
+    vector<string> actions;
+    vector<Rule> rules;          // rule 0 is $accept : start
+    int endToken = -1;
+
+    static bool isToken(int symbol) { return symbol < static_cast<int>(MAX_TOKENS); }
+
+    void parseLine(const string &line)
+    {
+        istringstream fields(line);
+        string word;
+        if (!(fields >> word) || word[0] == '#')
+            return;
+        if (word == "%tokens")
+        {
+            while (fields >> word)
+                tokens.push_back(word);
+            if (tokens.size() > MAX_TOKENS)
+                throw runtime_error("too many tokens");
+            return;
+        }
+        if (word == "%end")
+        {
+            if (!(fields >> word) || (endToken = tokenIndex(word)) < 0)
+                throw runtime_error("%end needs a token from %tokens");
+            return;
+        }
+        if (tokens.empty())
+            throw runtime_error("rules must follow %tokens");
+
+        if (rules.empty())
+        {
+            nonterminals.push_back("$accept");
+            rules.push_back(Rule{0, {MAX_TOKENS + 1}, actionIndex("ACCEPT")});
+        }
+        Rule rule{nonterminalIndex(word), {}, -1};
+        if (!(fields >> word) || word != ":")
+            throw runtime_error("expected ':' after " + nonterminals[rule.lhs]);
+        while (fields >> word && word != "=")
+        {
+            int token = tokenIndex(word);
+            rule.rhs.push_back(token >= 0 ? token : static_cast<int>(MAX_TOKENS) + nonterminalIndex(word));
+        }
+        if (word != "=" || !(fields >> word))
+            throw runtime_error("expected '= ACTION' at the end of the rule");
+        rule.action = actionIndex(word);
+        rules.push_back(rule);
+    }
+
+    void check() const
+    {
+        if (rules.empty())
+            throw runtime_error("no rules");
+        if (endToken < 0)
+            throw runtime_error("no %end token");
+        for (size_t n = 1; n < nonterminals.size(); n++)
+            if (none_of(rules.begin(), rules.end(), [&](const Rule &rule)
+                        { return rule.lhs == static_cast<int>(n); }))
+                throw runtime_error("no rule for " + nonterminals[n]);
+    }
+
+    string symbolName(int symbol) const
+    {
+        return isToken(symbol) ? tokens[symbol] : nonterminals[symbol - MAX_TOKENS];
+    }
+
+private:
+    int tokenIndex(const string &name) const
+    {
+        auto it = find(tokens.begin(), tokens.end(), name);
+        return it == tokens.end() ? -1 : static_cast<int>(it - tokens.begin());
+    }
+
+    int nonterminalIndex(const string &name)
+    {
+        auto it = find(nonterminals.begin(), nonterminals.end(), name);
+        if (it != nonterminals.end())
+            return static_cast<int>(it - nonterminals.begin());
+        nonterminals.push_back(name);
+        return static_cast<int>(nonterminals.size()) - 1;
+    }
+
+    int actionIndex(const string &name)
+    {
+        auto it = find(actions.begin(), actions.end(), name);
+        if (it != actions.end())
+            return static_cast<int>(it - actions.begin());
+        actions.push_back(name);
+        return static_cast<int>(actions.size()) - 1;
+    }
+};
+
+class LalrBuilder
+{
+public:
+    vector<vector<int>> action;   // action[state][token], encoded as in the header
+    vector<vector<int>> gotoNext; // gotoNext[state][nonterminal], -1 if none
+    int conflicts = 0;
+
+    explicit LalrBuilder(const Grammar &grammar) : g(grammar) {}
+
+    void build()
+    {
+        computeFirst();
+        buildLr0();
+        propagateLookaheads();
+        buildTables();
+    }
+
+    size_t stateCount() const { return kernels.size(); }
+
+private:
+    const Grammar &g;
+    vector<bool> nullable;           // per nonterminal
+    vector<TokenSet> first;          // per nonterminal
+    vector<vector<Item>> kernels;    // kernel items of each LR(0) state
+    vector<map<int, int>> edges;     // edges[state][symbol] = target state
+    vector<vector<TokenSet>> kernelLookahead; // per state, per kernel item
+
+    void computeFirst()
+    {
+        nullable.assign(g.nonterminals.size(), false);
+        first.assign(g.nonterminals.size(), TokenSet());
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            for (const Rule &rule : g.rules)
+            {
+                TokenSet set;
+                bool allNullable = sequenceFirst(rule.rhs, 0, set);
+                TokenSet merged = first[rule.lhs] | set;
+                if (merged != first[rule.lhs] || (allNullable && !nullable[rule.lhs]))
+                {
+                    first[rule.lhs] = merged;
+                    nullable[rule.lhs] = nullable[rule.lhs] || allNullable;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    // Adds FIRST(symbols[from..]) to set; returns whether that whole suffix can derive the empty string.
+    bool sequenceFirst(const vector<int> &symbols, size_t from, TokenSet &set) const
+    {
+        for (size_t i = from; i < symbols.size(); i++)
+        {
+            if (Grammar::isToken(symbols[i]))
+            {
+                set.set(symbols[i]);
+                return false;
+            }
+            int n = symbols[i] - MAX_TOKENS;
+            set |= first[n];
+            if (!nullable[n])
+                return false;
+        }
+        return true;
+    }
+
+    int symbolAfterDot(const Item &item) const
+    {
+        const vector<int> &rhs = g.rules[item.rule].rhs;
+        return item.dot < static_cast<int>(rhs.size()) ? rhs[item.dot] : -1;
+    }
+
+    vector<Item> closure0(const vector<Item> &kernel) const
+    {
+        vector<Item> items = kernel;
+        vector<bool> added(g.nonterminals.size());
+        for (size_t i = 0; i < items.size(); i++)
+        {
+            int symbol = symbolAfterDot(items[i]);
+            if (symbol < 0 || Grammar::isToken(symbol) || added[symbol - MAX_TOKENS])
+                continue;
+            added[symbol - MAX_TOKENS] = true;
+            for (size_t r = 0; r < g.rules.size(); r++)
+                if (g.rules[r].lhs == symbol - static_cast<int>(MAX_TOKENS))
+                    items.push_back(Item{static_cast<int>(r), 0});
+        }
+        return items;
+    }
+
+    void buildLr0()
+    {
+        map<vector<Item>, int> ids;
+        kernels.push_back({Item{0, 0}});
+        ids.emplace(kernels[0], 0);
+        for (size_t state = 0; state < kernels.size(); state++)
+        {
+            map<int, vector<Item>> moved;
+            for (const Item &item : closure0(kernels[state]))
+            {
+                int symbol = symbolAfterDot(item);
+                if (symbol >= 0)
+                    moved[symbol].push_back(Item{item.rule, item.dot + 1});
+            }
+            edges.emplace_back();
+            for (auto &entry : moved)
+            {
+                vector<Item> &kernel = entry.second;
+                sort(kernel.begin(), kernel.end());
+                auto it = ids.find(kernel);
+                if (it == ids.end())
+                {
+                    it = ids.emplace(kernel, static_cast<int>(kernels.size())).first;
+                    kernels.push_back(kernel);
+                }
+                edges[state][entry.first] = it->second;
+            }
+        }
+    }
+
+    // LR(1) closure of a state's kernel with the current lookaheads: every item with its lookahead set.
+    vector<pair<Item, TokenSet>> closure1(size_t state) const
+    {
+        vector<pair<Item, TokenSet>> items;
+        map<Item, size_t> index;
+        for (size_t k = 0; k < kernels[state].size(); k++)
+        {
+            index[kernels[state][k]] = items.size();
+            items.emplace_back(kernels[state][k], kernelLookahead[state][k]);
+        }
+        vector<size_t> work(items.size());
+        for (size_t i = 0; i < work.size(); i++)
+            work[i] = i;
+        while (!work.empty())
+        {
+            size_t i = work.back();
+            work.pop_back();
+            Item item = items[i].first;
+            int symbol = symbolAfterDot(item);
+            if (symbol < 0 || Grammar::isToken(symbol))
+                continue;
+            TokenSet lookahead;
+            if (sequenceFirst(g.rules[item.rule].rhs, item.dot + 1, lookahead))
+                lookahead |= items[i].second;
+            for (size_t r = 0; r < g.rules.size(); r++)
+            {
+                if (g.rules[r].lhs != symbol - static_cast<int>(MAX_TOKENS))
+                    continue;
+                Item start{static_cast<int>(r), 0};
+                auto it = index.find(start);
+                if (it == index.end())
+                {
+                    index[start] = items.size();
+                    items.emplace_back(start, lookahead);
+                    work.push_back(items.size() - 1);
+                }
+                else if ((items[it->second].second | lookahead) != items[it->second].second)
+                {
+                    items[it->second].second |= lookahead;
+                    work.push_back(it->second);
+                }
+            }
+        }
+        return items;
+    }
+
+    void propagateLookaheads()
+    {
+        kernelLookahead.resize(kernels.size());
+        for (size_t state = 0; state < kernels.size(); state++)
+            kernelLookahead[state].assign(kernels[state].size(), TokenSet());
+        kernelLookahead[0][0].set(g.endToken);
+
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            for (size_t state = 0; state < kernels.size(); state++)
+            {
+                for (const auto &entry : closure1(state))
+                {
+                    int symbol = symbolAfterDot(entry.first);
+                    if (symbol < 0)
+                        continue;
+                    int target = edges[state].at(symbol);
+                    Item moved{entry.first.rule, entry.first.dot + 1};
+                    size_t k = lower_bound(kernels[target].begin(), kernels[target].end(), moved) - kernels[target].begin();
+                    TokenSet merged = kernelLookahead[target][k] | entry.second;
+                    if (merged != kernelLookahead[target][k])
+                    {
+                        kernelLookahead[target][k] = merged;
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+
+    void buildTables()
+    {
+        action.assign(kernels.size(), vector<int>(g.tokens.size(), 0));
+        gotoNext.assign(kernels.size(), vector<int>(g.nonterminals.size(), -1));
+        for (size_t state = 0; state < kernels.size(); state++)
+        {
+            for (const auto &entry : edges[state])
+            {
+                if (Grammar::isToken(entry.first))
+                    action[state][entry.first] = entry.second + 1;
+                else
+                    gotoNext[state][entry.first - MAX_TOKENS] = entry.second;
+            }
+            for (const auto &entry : closure1(state))
+            {
+                if (symbolAfterDot(entry.first) >= 0)
+                    continue;
+                int reduce = -entry.first.rule - 1;
+                for (size_t token = 0; token < g.tokens.size(); token++)
+                {
+                    if (!entry.second.test(token))
+                        continue;
+                    int &cell = action[state][token];
+                    if (cell == 0)
+                        cell = reduce;
+                    else if (cell > 0)
+                    {
+                        conflicts++;
+                        cerr << "state " << state << ": shift/reduce conflict on " << g.tokens[token]
+                             << " (rule " << entry.first.rule << "), resolved as shift" << endl;
+                    }
+                    else if (cell != reduce)
+                        throw runtime_error("state " + to_string(state) + ": reduce/reduce conflict on " + g.tokens[token] +
+                                            " between rules " + to_string(-cell - 1) + " and " + to_string(entry.first.rule));
+                }
+            }
+        }
+    }
+};
+
+void writeHeader(ostream &out, const string &specName, const Grammar &g, const LalrBuilder &lalr)
+{
+    size_t states = lalr.stateCount();
+    out << "// Generated by lalrgen from " << specName << "; do not edit, change the grammar and regenerate.\n"
+        << "// LALR(1) tables with " << states << " states, " << g.rules.size() << " rules and "
+        << lalr.conflicts << " shift/reduce conflicts resolved as shift.\n"
+        << "// TokenType must be declared before this header is included.\n"
+        << "#include <cstdint>\n\n";
+    for (size_t token = 0; token < g.tokens.size(); token++)
+        out << "static_assert(" << g.tokens[token] << " == " << token << ", \"TokenType does not match %tokens in "
+            << specName << "\");\n";
+    out << "\nconst int LALR_STATES = " << states << ";\n"
+        << "const int LALR_TOKENS = " << g.tokens.size() << ";\n"
+        << "const int LALR_NONTERMINALS = " << g.nonterminals.size() << ";\n"
+        << "const int LALR_RULES = " << g.rules.size() << ";\n\n"
+        << "enum LalrAction : uint8_t\n{\n";
+    for (const string &action : g.actions)
+        out << "    A_" << action << ",\n";
+    out << "};\n\n"
+        << "// 0: syntax error, s > 0: shift and go to state s - 1, r < 0: reduce by rule -r - 1 (rule 0 accepts).\n"
+        << "const int16_t LALR_ACTION[LALR_STATES][LALR_TOKENS] = {\n";
+    for (const vector<int> &row : lalr.action)
+    {
+        out << "    {";
+        for (size_t i = 0; i < row.size(); i++)
+            out << (i ? "," : "") << row[i];
+        out << "},\n";
+    }
+    out << "};\n\n"
+        << "// State after reducing to a nonterminal, -1 where no rule leads.\n"
+        << "const int16_t LALR_GOTO[LALR_STATES][LALR_NONTERMINALS] = {\n";
+    for (const vector<int> &row : lalr.gotoNext)
+    {
+        out << "    {";
+        for (size_t i = 0; i < row.size(); i++)
+            out << (i ? "," : "") << row[i];
+        out << "},\n";
+    }
+    out << "};\n\n";
+
+    out << "// Rules:\n";
+    for (size_t r = 0; r < g.rules.size(); r++)
+    {
+        out << "//  " << r << ": " << g.nonterminals[g.rules[r].lhs] << " :";
+        for (int symbol : g.rules[r].rhs)
+            out << " " << g.symbolName(symbol);
+        out << " = " << g.actions[g.rules[r].action] << "\n";
+    }
+    out << "const uint8_t LALR_RULE_LHS[LALR_RULES] = {";
+    for (size_t r = 0; r < g.rules.size(); r++)
+        out << (r ? ", " : "") << g.rules[r].lhs;
+    out << "};\n"
+        << "const uint8_t LALR_RULE_LENGTH[LALR_RULES] = {";
+    for (size_t r = 0; r < g.rules.size(); r++)
+        out << (r ? ", " : "") << g.rules[r].rhs.size();
+    out << "};\n"
+        << "const LalrAction LALR_RULE_ACTION[LALR_RULES] = {";
+    for (size_t r = 0; r < g.rules.size(); r++)
+        out << (r ? ", " : "") << "A_" << g.actions[g.rules[r].action];
+    out << "};\n";
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 2)
+    {
+        cerr << "Usage: " << argv[0] << " <grammar>" << endl;
+        return 1;
+    }
+    ifstream spec(argv[1]);
+    if (!spec)
+    {
+        cerr << "Cannot open " << argv[1] << endl;
+        return 1;
+    }
+
+    Grammar grammar;
+    string line;
+    int lineNumber = 0;
+    try
+    {
+        while (getline(spec, line))
+        {
+            lineNumber++;
+            grammar.parseLine(line);
+        }
+        lineNumber = 0;
+        grammar.check();
+    }
+    catch (const runtime_error &e)
+    {
+        cerr << argv[1] << (lineNumber ? ":" + to_string(lineNumber) : string()) << ": " << e.what() << endl;
+        return 1;
+    }
+
+    LalrBuilder lalr(grammar);
+    try
+    {
+        lalr.build();
+    }
+    catch (const runtime_error &e)
+    {
+        cerr << argv[1] << ": " << e.what() << endl;
+        return 1;
+    }
+    if (lalr.stateCount() > 32767 || grammar.nonterminals.size() > 255 || grammar.rules.size() > 32767)
+    {
+        cerr << argv[1] << ": grammar too large for the table types" << endl;
+        return 1;
+    }
+    writeHeader(cout, argv[1], grammar, lalr);
+    return 0;
+}
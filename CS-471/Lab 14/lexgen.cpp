@@ -0,0 +1,434 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <bitset>
+#include <map>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+/*
+    lexgen: lexer generator for the hand-written lexers in this lab.
+
+    It reads a token specification and prints a C++ header with a minimized DFA for it:
+
+        lexgen cc.tokens > cc_dfa.h
+
+    Specification: one token per line, "KIND regex", where KIND is the TokenType the lexer returns
+    for it. Blank lines and lines starting with # are ignored. When two tokens match the same
+    longest prefix, the one listed first wins (so keywords go before identifiers).
+    Regex syntax: literal characters, \ escapes (\n \t \r \f \v, anything else stands for itself),
+    character classes [a-z] and [^...], . (any byte but newline), grouping ( ), alternation |,
+    and the postfix operators * + ?.
+
+    The generated header has
+    - DFA_NEXT[state][byte]: the next state, one lookup per input byte. State 0 is the dead state
+      (no token can continue) and state 1 the start state.
+    - DFA_ACCEPT[state]: the token kind the state accepts, or -1.
+    - matchToken(): the scanning loop, which returns the kind and length of the longest token at
+      a position, so every lexer that includes a generated header shares the same engine.
+    TokenType must be declared before the header is included.
+
+    Steps: regex -> Thompson NFA -> subset construction -> Moore partition refinement.
+*/
+
+struct NfaState
+{
+    bitset<256> chars; // bytes that lead to next
+    int next = -1;
+    vector<int> epsilon;
+    int rule = -1; // index of the spec line this state accepts, -1 if not accepting
+};
+
+struct Fragment
+{
+    int start;
+    int end;
+};
+
+class RegexParser
+{
+public:
+    RegexParser(const string &regex, vector<NfaState> &nfa) : regex(regex), pos(0), nfa(nfa) {}
+
+    Fragment parse()
+    {
+        Fragment fragment = parseAlternation();
+        if (pos != regex.size())
+            fail("unexpected '" + string(1, regex[pos]) + "'");
+        return fragment;
+    }
+
+private:
+    const string &regex;
+    size_t pos;
+    vector<NfaState> &nfa;
+
+    [[noreturn]] void fail(const string &message)
+    {
+        throw runtime_error("regex \"" + regex + "\": " + message);
+    }
+
+    int newState()
+    {
+        nfa.emplace_back();
+        return static_cast<int>(nfa.size() - 1);
+    }
+
+    Fragment parseAlternation()
+    {
+        Fragment left = parseConcatenation();
+        while (pos < regex.size() && regex[pos] == '|')
+        {
+            pos++;
+            Fragment right = parseConcatenation();
+            int start = newState();
+            int end = newState();
+            nfa[start].epsilon = {left.start, right.start};
+            nfa[left.end].epsilon.push_back(end);
+            nfa[right.end].epsilon.push_back(end);
+            left = Fragment{start, end};
+        }
+        return left;
+    }
+
+    Fragment parseConcatenation()
+    {
+        int start = newState();
+        Fragment result{start, start};
+        while (pos < regex.size() && regex[pos] != '|' && regex[pos] != ')')
+        {
+            Fragment next = parseRepetition();
+            nfa[result.end].epsilon.push_back(next.start);
+            result.end = next.end;
+        }
+        return result;
+    }
+
+    Fragment parseRepetition()
+    {
+        Fragment atom = parseAtom();
+        while (pos < regex.size() && (regex[pos] == '*' || regex[pos] == '+' || regex[pos] == '?'))
+        {
+            char op = regex[pos++];
+            int start = newState();
+            int end = newState();
+            nfa[start].epsilon.push_back(atom.start);
+            nfa[atom.end].epsilon.push_back(end);
+            if (op != '+')
+                nfa[start].epsilon.push_back(end); // zero times
+            if (op != '?')
+                nfa[atom.end].epsilon.push_back(atom.start); // again
+            atom = Fragment{start, end};
+        }
+        return atom;
+    }
+
+    Fragment parseAtom()
+    {
+        if (pos >= regex.size())
+            fail("missing operand");
+        char current = regex[pos];
+        if (current == '(')
+        {
+            pos++;
+            Fragment inner = parseAlternation();
+            if (pos >= regex.size() || regex[pos] != ')')
+                fail("missing ')'");
+            pos++;
+            return inner;
+        }
+        if (current == '*' || current == '+' || current == '?')
+            fail("nothing to repeat");
+
+        bitset<256> chars;
+        if (current == '[')
+        {
+            pos++;
+            chars = parseClass();
+        }
+        else if (current == '.')
+        {
+            pos++;
+            chars.set();
+            chars.reset('\n');
+        }
+        else
+        {
+            chars.set(parseChar());
+        }
+        int start = newState();
+        int end = newState();
+        nfa[start].chars = chars;
+        nfa[start].next = end;
+        return Fragment{start, end};
+    }
+
+    // Parses the rest of a [...] class, after the '['.
+    bitset<256> parseClass()
+    {
+        bool negate = pos < regex.size() && regex[pos] == '^';
+        if (negate)
+            pos++;
+        bitset<256> chars;
+        while (pos < regex.size() && regex[pos] != ']')
+        {
+            unsigned char low = parseChar();
+            unsigned char high = low;
+            if (pos + 1 < regex.size() && regex[pos] == '-' && regex[pos + 1] != ']')
+            {
+                pos++;
+                high = parseChar();
+                if (high < low)
+                    fail("bad range");
+            }
+            for (int c = low; c <= high; c++)
+                chars.set(c);
+        }
+        if (pos >= regex.size())
+            fail("missing ']'");
+        pos++;
+        if (negate)
+            chars.flip();
+        return chars;
+    }
+
+    unsigned char parseChar()
+    {
+        char current = regex[pos++];
+        if (current != '\\')
+            return current;
+        if (pos >= regex.size())
+            fail("trailing '\\'");
+        switch (char escaped = regex[pos++])
+        {
+        case 'n':
+            return '\n';
+        case 't':
+            return '\t';
+        case 'r':
+            return '\r';
+        case 'f':
+            return '\f';
+        case 'v':
+            return '\v';
+        default:
+            return escaped;
+        }
+    }
+};
+
+class DfaBuilder
+{
+public:
+    vector<vector<int>> next; // next[state][byte]
+    vector<int> accept;       // rule index accepted by the state, -1 if none
+
+    // Subset construction; DFA state 0 is the empty set (dead state), 1 the start state.
+    void build(const vector<NfaState> &nfa, int nfaStart)
+    {
+        map<vector<int>, int> ids;
+        vector<vector<int>> sets;
+        auto idOf = [&](vector<int> set)
+        {
+            auto it = ids.find(set);
+            if (it != ids.end())
+                return it->second;
+            int id = static_cast<int>(sets.size());
+            ids.emplace(set, id);
+            sets.push_back(move(set));
+            return id;
+        };
+        idOf({});
+        idOf(closure(nfa, {nfaStart}));
+
+        for (size_t state = 0; state < sets.size(); state++)
+        {
+            vector<int> row(256);
+            for (int c = 0; c < 256; c++)
+            {
+                vector<int> moved;
+                for (int s : sets[state])
+                    if (nfa[s].next >= 0 && nfa[s].chars.test(c))
+                        moved.push_back(nfa[s].next);
+                row[c] = idOf(closure(nfa, moved));
+            }
+            next.push_back(row);
+
+            int rule = -1;
+            for (int s : sets[state])
+                if (nfa[s].rule >= 0 && (rule < 0 || nfa[s].rule < rule))
+                    rule = nfa[s].rule;
+            accept.push_back(rule);
+        }
+    }
+
+    // Moore partition refinement: states stay together while they accept the same rule and
+    // every byte takes them to the same group. The dead state's group becomes 0, the start's 1.
+    void minimize()
+    {
+        vector<int> group(accept.begin(), accept.end());
+        size_t groupCount = 0;
+        while (true)
+        {
+            map<vector<int>, int> signatures;
+            vector<int> refined(next.size());
+            for (size_t state = 0; state < next.size(); state++)
+            {
+                vector<int> signature{group[state]};
+                for (int target : next[state])
+                    signature.push_back(group[target]);
+                refined[state] = signatures.emplace(signature, static_cast<int>(signatures.size())).first->second;
+            }
+            group = refined;
+            if (signatures.size() == groupCount)
+                break;
+            groupCount = signatures.size();
+        }
+
+        vector<int> renumber(groupCount, -1);
+        int nextId = 0;
+        renumber[group[0]] = nextId++;
+        if (renumber[group[1]] < 0)
+            renumber[group[1]] = nextId++;
+        for (size_t state = 0; state < next.size(); state++)
+            if (renumber[group[state]] < 0)
+                renumber[group[state]] = nextId++;
+
+        vector<vector<int>> minimalNext(groupCount, vector<int>(256));
+        vector<int> minimalAccept(groupCount);
+        for (size_t state = 0; state < next.size(); state++)
+        {
+            int id = renumber[group[state]];
+            for (int c = 0; c < 256; c++)
+                minimalNext[id][c] = renumber[group[next[state][c]]];
+            minimalAccept[id] = accept[state];
+        }
+        next = minimalNext;
+        accept = minimalAccept;
+    }
+
+private:
+    static vector<int> closure(const vector<NfaState> &nfa, vector<int> states)
+    {
+        vector<bool> seen(nfa.size());
+        for (int s : states)
+            seen[s] = true;
+        for (size_t i = 0; i < states.size(); i++)
+            for (int target : nfa[states[i]].epsilon)
+                if (!seen[target])
+                {
+                    seen[target] = true;
+                    states.push_back(target);
+                }
+        sort(states.begin(), states.end());
+        return states;
+    }
+};
+
+void writeHeader(ostream &out, const string &specName, const vector<string> &kinds, const DfaBuilder &dfa)
+{
+    size_t states = dfa.next.size();
+    const char *cellType = states <= 256 ? "uint8_t" : "uint16_t";
+
+    out << "// Generated by lexgen from " << specName << "; do not edit, change the spec and regenerate.\n"
+        << "// Minimized DFA with " << states << " states. State 0 is the dead state, state 1 the start state.\n"
+        << "// TokenType must be declared before this header is included.\n"
+        << "#include <cstddef>\n"
+        << "#include <cstdint>\n\n"
+        << "const int DFA_STATES = " << states << ";\n\n"
+        << "const " << cellType << " DFA_NEXT[DFA_STATES][256] = {\n";
+    for (const vector<int> &row : dfa.next)
+    {
+        out << "    {";
+        for (int c = 0; c < 256; c++)
+            out << (c ? (c % 32 ? "," : ",\n     ") : "") << row[c];
+        out << "},\n";
+    }
+    out << "};\n\n"
+        << "// Token kind accepted in each state, -1 if the state does not end a token.\n"
+        << "const int DFA_ACCEPT[DFA_STATES] = {";
+    for (size_t state = 0; state < states; state++)
+        out << (state ? ", " : "") << (dfa.accept[state] < 0 ? "-1" : kinds[dfa.accept[state]]);
+    out << "};\n\n"
+        << "// Longest token starting at p (and ending before end): returns its kind and sets length,\n"
+        << "// or returns -1 if no token starts at p.\n"
+        << "inline int matchToken(const char *p, const char *end, size_t &length)\n"
+        << "{\n"
+        << "    int state = 1;\n"
+        << "    int kind = -1;\n"
+        << "    length = 0;\n"
+        << "    for (const char *q = p; q < end; q++)\n"
+        << "    {\n"
+        << "        state = DFA_NEXT[state][static_cast<unsigned char>(*q)];\n"
+        << "        if (state == 0)\n"
+        << "            break;\n"
+        << "        if (DFA_ACCEPT[state] >= 0)\n"
+        << "        {\n"
+        << "            kind = DFA_ACCEPT[state];\n"
+        << "            length = q - p + 1;\n"
+        << "        }\n"
+        << "    }\n"
+        << "    return kind;\n"
+        << "}\n";
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 2)
+    {
+        cerr << "Usage: " << argv[0] << " <token spec>" << endl;
+        return 1;
+    }
+    ifstream spec(argv[1]);
+    if (!spec)
+    {
+        cerr << "Cannot open " << argv[1] << endl;
+        return 1;
+    }
+
+    vector<NfaState> nfa(1); // state 0 is the common start, with an epsilon edge to every token
+    vector<string> kinds;
+    string line;
+    int lineNumber = 0;
+    try
+    {
+        while (getline(spec, line))
+        {
+            lineNumber++;
+            istringstream fields(line);
+            string kind;
+            if (!(fields >> kind) || kind[0] == '#')
+                continue;
+            string regex;
+            getline(fields >> ws, regex);
+            regex.erase(regex.find_last_not_of(" \t\r") + 1);
+            if (regex.empty())
+                throw runtime_error("no regex for " + kind);
+
+            Fragment fragment = RegexParser(regex, nfa).parse();
+            nfa[0].epsilon.push_back(fragment.start);
+            nfa[fragment.end].rule = static_cast<int>(kinds.size());
+            kinds.push_back(kind);
+        }
+    }
+    catch (const runtime_error &e)
+    {
+        cerr << argv[1] << ":" << lineNumber << ": " << e.what() << endl;
+        return 1;
+    }
+    if (kinds.empty())
+    {
+        cerr << argv[1] << ": no tokens" << endl;
+        return 1;
+    }
+
+    DfaBuilder dfa;
+    dfa.build(nfa, 0);
+    dfa.minimize();
+    writeHeader(cout, argv[1], kinds, dfa);
+    return 0;
+}
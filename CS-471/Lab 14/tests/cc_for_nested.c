@@ -0,0 +1,9 @@
+int sum;
+int i;
+int j;
+sum = 0;
+for(i = 0; 3 > i; i = (i + 1)){
+    for(j = i; 4 > j; j = (j + 1) * 2){
+        sum = sum + i * j;
+    }
+}
@@ -0,0 +1,10 @@
+int i;
+int k;
+for(i = 0; 10 > i; i = ((i + 1) * (2 - 1));){
+    for(k = (i); k < (i * 2); k = (k + (1));)
+        i = i + k;
+}
+for(i = 0; i < 4; i = i + 1)
+    for(k = 0; k < i; k = (k + 1))
+        for(k = k; k > 100; k = (k - (1 + 1)))
+            i = i - 1;
@@ -0,0 +1,25 @@
+int iat;
+int elke;
+int fur;
+int whale;
+int reborn;
+int in;
+int integer;
+int iff;
+int elsewhere;
+int forx;
+int whiles;
+int returned;
+iat = 1;
+elke = iat + 2;
+fur = elke * 3;
+whale = fur - iat;
+reborn = whale / 2;
+in = reborn + integer;
+iff = in + elsewhere;
+forx = iff + whiles;
+returned = forx + 1;
+if (returned > iat) {
+    int esse;
+    esse = returned;
+}
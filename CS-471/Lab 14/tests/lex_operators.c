@@ -0,0 +1,8 @@
+int a1;int b2;
+a1=b2==3;a1 != b2;a1<=b2>=a1<b2>a1;
+x1=>=<==!==;
+while(a1>0){a1=a1-1;}return a1;
+if (a1 >= 10) { b2 = a1 * (b2 / 2); } else { b2 = 0; }
+	intx int9 whilex returnx 007 10x
+a1 =
+= b2 ;
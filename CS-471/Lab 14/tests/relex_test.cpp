@@ -0,0 +1,78 @@
+// Test for Lexer::relex: applies random edit sequences to random sources, some with unexpected
+// characters, and after every edit compares the EditableTokens that relex produced with
+// tokenizeForEditing() on the edited source, token by token and error by error. Small sources fit in one
+// block; the large ones span many blocks and get edits that cross, merge and split them.
+#include <random>
+
+#define main ccMain
+#include "../cc.cpp"
+#undef main
+
+static bool sameTokens(const EditableTokens &a, const EditableTokens &b)
+{
+    if (a.size() != b.size() || a.errorCount() != b.errorCount())
+        return false;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        Token x = a.at(i), y = b.at(i);
+        if (x.type != y.type || x.value != y.value || x.value.data() != y.value.data() ||
+            x.lineNumber != y.lineNumber || x.id != y.id || x.offset != y.offset)
+            return false;
+    }
+    for (size_t i = 0; i < a.errorCount(); i++)
+    {
+        LexError x = a.error(i), y = b.error(i);
+        if (x.offset != y.offset || x.lineNumber != y.lineNumber || x.character != y.character)
+            return false;
+    }
+    return true;
+}
+
+int main()
+{
+    mt19937 random(11);
+    const char *pieces[] = {" ", "\n", "x", "12", "int", "for", "=", "==", "!", "!=", ";", "(", ")", "{", "}",
+                            "+", "ab1", "7", "\n\n", "\t", "if", "i", "<", ">=", "@"};
+    auto randomText = [&](size_t length)
+    {
+        string text;
+        while (text.size() < length)
+            text += pieces[random() % size(pieces)];
+        return text;
+    };
+
+    size_t edits = 0;
+    for (int round = 0; round < 5100; round++)
+    {
+        bool large = round >= 5000;
+        size_t maxLength = large ? 40000 : 200;
+        size_t maxEdit = large ? 5000 : 6;
+        string text = randomText(random() % maxLength);
+        StringInterner names;
+        Lexer lexer(text, names);
+        EditableTokens tokens = lexer.tokenizeForEditing();
+        for (int step = 0; step < (large ? 40 : 10); step++)
+        {
+            size_t offset = random() % (text.size() + 1);
+            size_t removed = random() % (text.size() - offset + 1);
+            if (random() % 2)
+                removed = min<size_t>(removed, random() % 2 ? 3 : maxEdit);
+            string inserted = random() % 3 ? randomText(random() % maxEdit) : string();
+            string edited = text.substr(0, offset) + inserted + text.substr(offset + removed);
+            text.swap(edited);
+
+            bool clean = lexer.relex(tokens, text, TextEdit{offset, removed, inserted.size()});
+            Lexer fresh(text, names);
+            EditableTokens expected = fresh.tokenizeForEditing();
+            if (!sameTokens(tokens, expected) || clean != (expected.errorCount() == 0))
+            {
+                cout << "FAIL: relex differs from tokenizeForEditing in round " << round << ", edit " << step
+                     << " on:\n" << text << endl;
+                return 1;
+            }
+            edits++;
+        }
+    }
+    cout << edits << " edits, relex matched tokenizeForEditing" << endl;
+    return 0;
+}
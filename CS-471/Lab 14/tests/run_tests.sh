@@ -0,0 +1,57 @@
+#!/bin/sh
+# Tests for the Lab 14 compilers: builds cc.cpp (with Parser and with LalrParser) and tip.cpp, compiles every
+# cc_*.c with both cc builds and every tip_*.c with tip, and compares the three-address code they print with
+# the matching .tac file. relex_test.cpp checks incremental re-lexing against a full lex. When flex is
+# installed (FLEX picks the program), tokens.cpp is built with both of cc.cpp's scanners and their token
+# listings are compared on every .c file here; without flex that check is skipped.
+# Usage: sh run_tests.sh        (CXX picks the compiler, g++ by default)
+cd "$(dirname "$0")" || exit 1
+CXX=${CXX:-g++}
+work=$(mktemp -d) || exit 1
+trap 'rm -rf "$work"' EXIT
+$CXX -std=c++17 -O2 -o "$work/cc" ../cc.cpp || exit 1
+$CXX -std=c++17 -O2 -DCC_LALR_PARSER -o "$work/cc_lalr" ../cc.cpp || exit 1
+$CXX -std=c++17 -O2 -o "$work/tip" ../tip.cpp || exit 1
+$CXX -std=c++17 -O2 -o "$work/relex_test" relex_test.cpp || exit 1
+FLEX=${FLEX:-flex}
+
+tests=0
+failed=0
+# check NAME EXPECTED: compares the TAC in $work/out with EXPECTED
+check() {
+    tests=$((tests + 1))
+    if ! diff -u "$2" "$work/out" > "$work/diff"; then
+        echo "FAIL: $1"
+        cat "$work/diff"
+        failed=$((failed + 1))
+    fi
+}
+
+for input in cc_*.c; do
+    "$work/cc" "$input" | sed '/^=====/,$d' > "$work/out"
+    check "$input (Parser)" "${input%.c}.tac"
+    "$work/cc_lalr" "$input" | sed '/^=====/,$d' > "$work/out"
+    check "$input (LalrParser)" "${input%.c}.tac"
+done
+for input in tip_*.c; do
+    "$work/tip" "$input" | sed '/^Assembly Code:/,$d' > "$work/out"
+    check "$input" "${input%.c}.tac"
+done
+tests=$((tests + 1))
+if ! "$work/relex_test"; then
+    failed=$((failed + 1))
+fi
+if command -v "$FLEX" > /dev/null; then
+    "$FLEX" -o "$work/cc.yy.c" ../cc.l || exit 1
+    $CXX -std=c++17 -O2 -o "$work/tokens_hand" tokens.cpp || exit 1
+    $CXX -std=c++17 -O2 -DCC_FLEX_LEXER -I"$work" -o "$work/tokens_flex" tokens.cpp || exit 1
+    for input in *.c; do
+        "$work/tokens_hand" "$input" > "$work/expected"
+        "$work/tokens_flex" "$input" > "$work/out"
+        check "$input (flex tokens)" "$work/expected"
+    done
+else
+    echo "flex not found, flex token checks skipped (install flex or set FLEX)"
+fi
+echo "$tests tests, $failed failed"
+[ "$failed" -eq 0 ]
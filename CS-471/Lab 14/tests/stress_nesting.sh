@@ -0,0 +1,40 @@
+#!/bin/sh
+# Stress test for deeply nested cc.cpp sources: generates programs nested DEPTH levels deep (1,000,000 by
+# default) as nested blocks, nested ifs and nested while/for loops, compiles each with Parser and with
+# LalrParser, and checks that both finish and that the TAC has one loop or branch per level.
+# Usage: sh stress_nesting.sh [DEPTH]        (CXX picks the compiler, g++ by default)
+cd "$(dirname "$0")" || exit 1
+DEPTH=${1:-1000000}
+CXX=${CXX:-g++}
+work=$(mktemp -d) || exit 1
+trap 'rm -rf "$work"' EXIT
+$CXX -std=c++17 -O2 -o "$work/cc" ../cc.cpp || exit 1
+$CXX -std=c++17 -O2 -DCC_LALR_PARSER -o "$work/cc_lalr" ../cc.cpp || exit 1
+
+awk -v n="$DEPTH" 'BEGIN { print "int x;"; for (i = 0; i < n; i++) printf "{ "; print "x = 1;"; for (i = 0; i < n; i++) printf "} "; print "" }' > "$work/blocks.c"
+awk -v n="$DEPTH" 'BEGIN { print "int x;"; for (i = 0; i < n; i++) print "if (x > 0)"; print "x = 1;" }' > "$work/ifs.c"
+awk -v n="$DEPTH" 'BEGIN { print "int x;"; for (i = 0; i < n; i++) print (i % 2 ? "for (x = 0; x > 0; x = (x + 1)) {" : "while (x > 0) {"); print "x = 1;"; for (i = 0; i < n; i++) printf "} "; print "" }' > "$work/loops.c"
+
+failed=0
+# check NAME FILE PATTERN COUNT: compiles FILE with both parsers and expects COUNT TAC lines matching PATTERN
+check() {
+    for cc in cc cc_lalr; do
+        if ! "$work/$cc" "$2" > "$work/full"; then
+            echo "FAIL: $1 ($cc) exited with an error"
+            failed=$((failed + 1))
+            continue
+        fi
+        sed '/^=====/,$d' "$work/full" > "$work/out"
+        found=$(grep -c -- "$3" "$work/out")
+        if [ "$found" -ne "$4" ]; then
+            echo "FAIL: $1 ($cc): $found lines match '$3', expected $4"
+            failed=$((failed + 1))
+        fi
+    done
+}
+
+check "nested blocks" "$work/blocks.c" '^x = 1$' 1
+check "nested ifs" "$work/ifs.c" '^if t[0-9]* goto L1$' "$DEPTH"
+check "nested loops" "$work/loops.c" '^goto L' "$DEPTH"
+echo "depth $DEPTH: $failed failed"
+[ "$failed" -eq 0 ]
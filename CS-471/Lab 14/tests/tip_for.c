@@ -0,0 +1,8 @@
+int n;
+n = 8;
+for(x = 0; n > x + 1; x = x * 2 + 1){
+    a = x;
+}
+for(y = n - 1; y > 0; y = y - 2){
+    b = y;
+}
@@ -0,0 +1,8 @@
+int n;
+n = 3;
+for(i = 0; n > i; i++){
+    a = i;
+}
+for(j = n; j > 0; j--){
+    b = j;
+}
@@ -0,0 +1,24 @@
+int iat;
+int elke;
+int flout;
+int deuble;
+int strong;
+int chur;
+int reborn;
+int whale;
+int fur;
+int iff;
+int chars;
+int strings;
+iat = 1;
+elke = iat + 2;
+flout = elke * 3;
+deuble = flout - iat;
+strong = deuble / 2;
+chur = strong + iff;
+reborn = chur + chars;
+whale = reborn + strings;
+fur = whale + 1;
+if (fur > iat) {
+    return fur;
+}
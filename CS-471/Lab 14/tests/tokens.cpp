@@ -0,0 +1,30 @@
+// Prints every token cc.cpp's Lexer produces for FILE, one per line: line, offset, type and lexeme.
+// run_tests.sh builds it with the hand-written scanner and, when flex is installed, with the flex
+// scanner (-DCC_FLEX_LEXER), and diffs the two listings on the test inputs.
+#define main ccMain
+#include "../cc.cpp"
+#undef main
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "Usage: " << argv[0] << " FILE" << endl;
+        return 1;
+    }
+    ifstream file(argv[1]);
+    if (!file)
+    {
+        cerr << "Cannot open " << argv[1] << endl;
+        return 1;
+    }
+    stringstream contents;
+    contents << file.rdbuf();
+    string src = contents.str();
+
+    StringInterner names;
+    Lexer lexer(src, names);
+    for (Token token = lexer.next(); token.type != T_EOF; token = lexer.next())
+        cout << token.lineNumber << ' ' << token.offset << ' ' << token.type << ' ' << token.value << '\n';
+    return 0;
+}
@@ -1,9 +1,14 @@
 #include <iostream>
 #include <vector>
+#include <iterator>
 #include <string>
+#include <cassert>
+#include <string_view>
 #include <cctype>
 #include <map>
 #include <sstream>
+#include <fstream>
+#include <charconv>
 
 using namespace std;
 
@@ -20,14 +25,86 @@ struct Token {
     TokenType type;
     string value;
     int line;
+    double number = 0; // value of a T_NUM literal, decoded once by the lexer
 };
 
+// Keyword lookup through a perfect hash built at compile time: findKeywordSeed searches for a seed
+// that puts every keyword in its own slot, so classifying a word is one hash and one compare.
+// The static_assert fires if a new keyword makes the set collide; then raise KEYWORD_SLOTS.
+struct Keyword {
+    string_view text;
+    TokenType type;
+};
+
+constexpr Keyword KEYWORDS[] = {
+    {"int", T_INT}, {"if", T_IF}, {"else", T_ELSE}, {"float", T_FLOAT}, {"double", T_DOUBLE},
+    {"string", T_STRING}, {"char", T_CHAR}, {"return", T_RETURN}, {"while", T_WHILE}, {"for", T_FOR},
+};
+
+constexpr size_t KEYWORD_SLOTS = 32; // power of two, larger than the number of keywords
+
+constexpr size_t keywordHash(string_view word, size_t seed) {
+    return (word.size() + static_cast<unsigned char>(word[0]) * seed +
+            static_cast<unsigned char>(word[word.size() - 1])) & (KEYWORD_SLOTS - 1);
+}
+
+constexpr size_t findKeywordSeed() {
+    for (size_t seed = 1; seed < 1000; seed++) {
+        bool used[KEYWORD_SLOTS] = {};
+        bool collision = false;
+        for (const Keyword &keyword : KEYWORDS) {
+            size_t slot = keywordHash(keyword.text, seed);
+            if (used[slot]) {
+                collision = true;
+                break;
+            }
+            used[slot] = true;
+        }
+        if (!collision) return seed;
+    }
+    return 0;
+}
+
+constexpr size_t KEYWORD_SEED = findKeywordSeed();
+static_assert(KEYWORD_SEED != 0, "No perfect hash seed found for KEYWORDS, increase KEYWORD_SLOTS.");
+
+struct KeywordTable {
+    Keyword slots[KEYWORD_SLOTS];
+};
+
+constexpr KeywordTable buildKeywordTable() {
+    KeywordTable table = {};
+    for (const Keyword &keyword : KEYWORDS) table.slots[keywordHash(keyword.text, KEYWORD_SEED)] = keyword;
+    return table;
+}
+
+constexpr KeywordTable KEYWORD_TABLE = buildKeywordTable();
+
+// Returns the keyword token type for word, or T_ID when word is not a keyword. word must not be empty.
+inline TokenType keywordOrIdentifier(string_view word) {
+    const Keyword &slot = KEYWORD_TABLE.slots[keywordHash(word, KEYWORD_SEED)];
+    return slot.text == word ? slot.type : T_ID;
+}
+
+// Token DFA generated by lexgen (lexgen.cpp) from tip.tokens; the Lexer matches each token with
+// matchToken, one table lookup per byte. Regenerate with: lexgen tip.tokens > tip_dfa.h
+#include "tip_dfa.h"
+
+// Pull lexer: the parser takes tokens with next() and looks ahead with peek(k). Scanned but
+// unconsumed tokens sit in a small ring buffer, so the full token list is never built.
+// tokenize() is kept as a wrapper that collects every token into a vector.
 class Lexer {
 private:
     string src;
     size_t pos;
     int line;
 
+    static constexpr size_t LOOKAHEAD = 4; // ring buffer size, must be a power of two
+    static_assert((LOOKAHEAD & (LOOKAHEAD - 1)) == 0, "LOOKAHEAD must be a power of two");
+    Token ring[LOOKAHEAD];
+    size_t head = 0;  // slot of the oldest buffered token
+    size_t count = 0; // number of buffered tokens
+
 public:
     Lexer(const string &src) {
         this->src = src;
@@ -35,8 +112,35 @@ public:
         this->line = 0;
     }
 
+    // k must be below LOOKAHEAD: the ring holds that many tokens, and a deeper peek would overwrite
+    // buffered tokens that have not been consumed yet.
+    const Token &peek(size_t k = 0) {
+        assert(k < LOOKAHEAD);
+        while (count <= k) {
+            ring[(head + count) & (LOOKAHEAD - 1)] = scanToken();
+            count++;
+        }
+        return ring[(head + k) & (LOOKAHEAD - 1)];
+    }
+
+    Token next() {
+        Token token = peek();
+        head = (head + 1) & (LOOKAHEAD - 1);
+        count--;
+        return token;
+    }
+
     vector<Token> tokenize() {
         vector<Token> tokens;
+        do {
+            tokens.push_back(next());
+        } while (tokens.back().type != T_EOF);
+        return tokens;
+    }
+
+private:
+    // Scans one token starting at pos, skipping whitespace and comments in front of it.
+    Token scanToken() {
         while (pos < src.size()) {
             char current = src[pos];
 
@@ -57,65 +161,32 @@ public:
                 continue;
             }
 
-            if (isdigit(current)) {
-                tokens.push_back(Token{T_NUM, consumeNumber(), line});
-                continue;
+            size_t length;
+            int kind = matchToken(src.data() + pos, src.data() + src.size(), length);
+            if (kind < 0) {
+                cout << "Unexpected character '" << current << "' at line " << line << endl;
+                exit(1);
             }
-
-            if (isalpha(current)) {
-                string word = consumeWord();
-                if (word == "int") tokens.push_back(Token{T_INT, word, line});
-                else if (word == "if") tokens.push_back(Token{T_IF, word, line});
-                else if (word == "else") tokens.push_back(Token{T_ELSE, word, line});
-                else if (word == "float") tokens.push_back(Token{T_FLOAT, word, line});
-                else if (word == "double") tokens.push_back(Token{T_DOUBLE, word, line});
-                else if (word == "string") tokens.push_back(Token{T_STRING, word, line});
-                else if (word == "char") tokens.push_back(Token{T_CHAR, word, line});
-                else if (word == "return") tokens.push_back(Token{T_RETURN, word, line});
-                else if (word == "while") tokens.push_back(Token{T_WHILE, word, line});
-                else if (word == "for") tokens.push_back(Token{T_FOR, word, line});
-                else tokens.push_back(Token{T_ID, word, line});
-                continue;
+            Token token{static_cast<TokenType>(kind), src.substr(pos, length), line};
+            pos += length;
+            if (token.type == T_ID) {
+                token.type = keywordOrIdentifier(token.value);
+            } else if (token.type == T_NUM) {
+                decodeNumber(token);
             }
-
-            switch (current) {
-                case '=': tokens.push_back(Token{T_ASSIGN, "=", line}); break;
-                case '+': tokens.push_back(Token{T_PLUS, "+", line}); break;
-                case '-': tokens.push_back(Token{T_MINUS, "-", line}); break;
-                case '*': tokens.push_back(Token{T_MUL, "*", line}); break;
-                case '/': tokens.push_back(Token{T_DIV, "/", line}); break;
-                case '(': tokens.push_back(Token{T_LPAREN, "(", line}); break;
-                case ')': tokens.push_back(Token{T_RPAREN, ")", line}); break;
-                case '{': tokens.push_back(Token{T_LBRACE, "{", line}); break;
-                case '}': tokens.push_back(Token{T_RBRACE, "}", line}); break;
-                case ';': tokens.push_back(Token{T_SEMICOLON, ";", line}); break;
-                case '>': tokens.push_back(Token{T_GT, ">", line}); break;
-                default:
-                    cout << "Unexpected character '" << current << "' at line " << line << endl;
-                    exit(1);
-            }
-            pos++;
+            return token;
         }
-        tokens.push_back(Token{T_EOF, "", line});
-        return tokens;
+        return Token{T_EOF, "", line};
     }
 
-    string consumeNumber() {
-        size_t start = pos;
-        bool dotFlag = false;
-        while (pos < src.size() && (isdigit(src[pos]) || (src[pos] == '.' && !dotFlag))) {
-            if (src[pos] == '.') {
-                dotFlag = true;
-            }
-            pos++;
+    // Fills in the value of a T_NUM token (an int or float literal).
+    void decodeNumber(Token &token) {
+        const char *text = token.value.data();
+        from_chars_result result = from_chars(text, text + token.value.size(), token.number);
+        if (result.ec == errc::result_out_of_range) {
+            cout << "Numeric literal '" << token.value << "' out of range at line " << line << endl;
+            exit(1);
         }
-        return src.substr(start, pos - start);
-    }
-
-    string consumeWord() {
-        size_t start = pos;
-        while (pos < src.size() && isalnum(src[pos])) pos++;
-        return src.substr(start, pos - start);
     }
 };
 
@@ -148,6 +219,19 @@ public:
    vector<string> getCode() const {
         return instructions;
     }
+
+    // mark and takeFrom cut the code emitted since a mark back out, so a parser can hold it as a fragment
+    // and emit it later (the for-loop update goes after the body although it is parsed before it).
+    size_t mark() const {
+        return instructions.size();
+    }
+
+    vector<string> takeFrom(size_t mark) {
+        vector<string> fragment(make_move_iterator(instructions.begin() + mark), make_move_iterator(instructions.end()));
+        instructions.resize(mark);
+        return fragment;
+    }
+
     string generateExpressionCode(const string &lhs, const string &op, const string &rhs) {
         string temp = newTemp();
         emit(temp + " = " + lhs + " " + op + " " + rhs);
@@ -174,20 +258,26 @@ public:
         emit(endLabel + ":");
     }
 
-    void generateForLoopCode(const string &init, const string &condition, const string &update, const vector<string> &body) {
+    // The init statement has been emitted already; conditionCode computes condition on every iteration and
+    // updateCode is the update statement, both cut out with takeFrom when they were parsed.
+    void generateForLoopCode(const vector<string> &conditionCode, const string &condition, const vector<string> &updateCode,
+                             const vector<string> &body) {
         string startLabel = newLabel();
         string endLabel = newLabel();
 
-        emit(init);
-
         emit(startLabel + ":");
+        for (const auto &inst : conditionCode) {
+            emit(inst);
+        }
         emit("if False " + condition + " goto " + endLabel);
 
         for (const auto &inst : body) {
             emit(inst);
         }
 
-        emit(update);
+        for (const auto &inst : updateCode) {
+            emit(inst);
+        }
         emit("goto " + startLabel);
         emit(endLabel + ":");
     }
@@ -195,57 +285,74 @@ public:
 
 class Parser {
 public:
-    Parser(const vector<Token> &tokens, ThreeAddressCodeGenerator &tac) : tokens(tokens), tac(tac), pos(0) {}
+    Parser(Lexer &lexer, ThreeAddressCodeGenerator &tac) : lexer(lexer), tac(tac) {}
 
     void parseProgram() {
-        while (tokens[pos].type != T_EOF) {
+        while (lexer.peek().type != T_EOF) {
             parseStatement();
         }
     }
 
 private:
-    vector<Token> tokens;
+    Lexer &lexer; // tokens are pulled from the lexer as the parser needs them
     ThreeAddressCodeGenerator &tac;
-    size_t pos;
 
     void parseStatement() {
-        if (tokens[pos].type == T_INT || tokens[pos].type == T_FLOAT || tokens[pos].type == T_DOUBLE ||
-            tokens[pos].type == T_STRING || tokens[pos].type == T_CHAR) {
+        if (lexer.peek().type == T_INT || lexer.peek().type == T_FLOAT || lexer.peek().type == T_DOUBLE ||
+            lexer.peek().type == T_STRING || lexer.peek().type == T_CHAR) {
             parseDeclaration();
-        } else if (tokens[pos].type == T_ID) {
+        } else if (lexer.peek().type == T_ID) {
             parseAssignment();
-        } else if (tokens[pos].type == T_IF) {
+        } else if (lexer.peek().type == T_IF) {
             parseIfStatement();
-        } else if (tokens[pos].type == T_RETURN) {
+        } else if (lexer.peek().type == T_RETURN) {
             parseReturnStatement();
-        } else if (tokens[pos].type == T_WHILE) {
+        } else if (lexer.peek().type == T_WHILE) {
             parseWhileStatement();
-        } else if (tokens[pos].type == T_FOR) {
+        } else if (lexer.peek().type == T_FOR) {
             parseForStatement();
         } else {
-            pos++;
+            lexer.next();
         }
     }
 
     void parseDeclaration() {
-        pos++;
-        string var = tokens[pos++].value;
+        lexer.next();
+        string var = lexer.next().value;
         tac.emit("Declare " + var);
-        if (tokens[pos].type == T_SEMICOLON) pos++;
+        if (lexer.peek().type == T_SEMICOLON) lexer.next();
     }
 
     void parseAssignment() {
-        string var = tokens[pos++].value;
-        pos++;
+        string var = lexer.next().value;
+        lexer.next();
         string expr = parseExpression();
         tac.generateAssignmentCode(var, expr);
-        if (tokens[pos].type == T_SEMICOLON) pos++;
+        if (lexer.peek().type == T_SEMICOLON) lexer.next();
     }
 
     string parseExpression() {
+        return parseComparison();
+    }
+
+    // '>' was added for for-loop conditions, which the parser could not read before. It is a new
+    // level, not a refactoring: every '>' now emits a "t = a > b" line, so the if and the for in
+    // the demo print more TAC than they used to, and the assembly has a MOV for each of those lines.
+    // Comparisons bind looser than + and -, so a loop condition like x > n + 1 compares against the sum.
+    string parseComparison() {
+        string lhs = parseSum();
+        while (lexer.peek().type == T_GT) {
+            string op = lexer.next().value;
+            string rhs = parseSum();
+            lhs = tac.generateExpressionCode(lhs, op, rhs);
+        }
+        return lhs;
+    }
+
+    string parseSum() {
         string lhs = parseTerm();
-        while (tokens[pos].type == T_PLUS || tokens[pos].type == T_MINUS) {
-            string op = tokens[pos++].value;
+        while (lexer.peek().type == T_PLUS || lexer.peek().type == T_MINUS) {
+            string op = lexer.next().value;
             string rhs = parseTerm();
             lhs = tac.generateExpressionCode(lhs, op, rhs);
         }
@@ -254,8 +361,8 @@ private:
 
     string parseTerm() {
         string lhs = parseFactor();
-        while (tokens[pos].type == T_MUL || tokens[pos].type == T_DIV) {
-            string op = tokens[pos++].value;
+        while (lexer.peek().type == T_MUL || lexer.peek().type == T_DIV) {
+            string op = lexer.next().value;
             string rhs = parseFactor();
             lhs = tac.generateExpressionCode(lhs, op, rhs);
         }
@@ -263,64 +370,79 @@ private:
     }
 
     string parseFactor() {
-        string value = tokens[pos].value;
-        pos++;
-        return value;
+        return lexer.next().value;
     }
 
     void parseIfStatement() {
-        pos++;
-        pos++;
+        lexer.next();
+        lexer.next();
         parseExpression();
-        pos++;
+        lexer.next();
         parseStatement();
     }
 
     void parseReturnStatement() {
-        pos++;
+        lexer.next();
         parseExpression();
-        pos++;
+        lexer.next();
     }
 
     void parseWhileStatement() {
-        pos++;
-        pos++;
+        lexer.next();
+        lexer.next();
         string condition = parseExpression();
-        pos++;
+        lexer.next();
         vector<string> body;
         parseLoopBody(body);
         tac.generateWhileLoopCode(condition, body);
     }
 
     void parseForStatement() {
-        pos++;
-        pos++;
-        string init = parseAssignmentStatement();
+        lexer.next();
+        lexer.next();
+        parseAssignmentStatement(); // the init runs once, before the loop, so its code stays where it is
+        size_t conditionMark = tac.mark();
         string condition = parseExpression();
-        pos++;
-        string update = parseAssignmentStatement();
-        pos++;
+        vector<string> conditionCode = tac.takeFrom(conditionMark);
+        lexer.next();
+        size_t updateMark = tac.mark();
+        parseAssignmentStatement(); // parsed once, here; its code is held back until after the body
+        vector<string> updateCode = tac.takeFrom(updateMark);
+        lexer.next();
         vector<string> body;
         parseLoopBody(body);
-        tac.generateForLoopCode(init, condition, update, body);
+        tac.generateForLoopCode(conditionCode, condition, updateCode, body);
     }
 
-    string parseAssignmentStatement() {
-        string var = tokens[pos++].value;
-        pos++;
-        string expr = parseExpression();
-        tac.generateAssignmentCode(var, expr);
-        if (tokens[pos].type == T_SEMICOLON) pos++;
-        return var + " = " + expr;
+    // The init and update of a for loop. x++ and x-- (two '+' or '-' tokens, as the lexer has no '++')
+    // compile to x = x + 1 and x = x - 1; anything else that is not "x = expression" is a syntax error.
+    void parseAssignmentStatement() {
+        Token target = lexer.next();
+        const Token &after = lexer.peek();
+        if (target.type == T_ID && (after.type == T_PLUS || after.type == T_MINUS) && lexer.peek(1).type == after.type) {
+            string op = lexer.next().value;
+            lexer.next();
+            string expr = tac.generateExpressionCode(target.value, op, "1");
+            tac.generateAssignmentCode(target.value, expr);
+        } else {
+            if (target.type != T_ID || after.type != T_ASSIGN) {
+                cout << "Syntax error: expected 'x = expression', 'x++' or 'x--' at line " << target.line << endl;
+                exit(1);
+            }
+            lexer.next();
+            string expr = parseExpression();
+            tac.generateAssignmentCode(target.value, expr);
+        }
+        if (lexer.peek().type == T_SEMICOLON) lexer.next();
     }
 
     void parseLoopBody(vector<string> &body) {
-        pos++;
-        while (tokens[pos].type != T_RBRACE) {
+        lexer.next();
+        while (lexer.peek().type != T_RBRACE) {
             body.push_back("...");  // Placeholder
-            pos++;
+            lexer.next();
         }
-        pos++;
+        lexer.next();
     }
 };
 class AssemblyCodeGenerator {
@@ -401,7 +523,8 @@ public:
         }
     }
 };
-int main() {
+// With a file argument the file is compiled instead of the demo program (tests/run_tests.sh uses this).
+int main(int argc, char *argv[]) {
     string input = R"(
         int a;
         a = 5;
@@ -414,12 +537,21 @@ int main() {
             a = x + 1;
         }
     )";
+    if (argc > 1) {
+        ifstream file(argv[1]);
+        if (!file) {
+            cout << "Error opening file: " << argv[1] << endl;
+            return 1;
+        }
+        stringstream contents;
+        contents << file.rdbuf();
+        input = contents.str();
+    }
 
     Lexer lexer(input);
-    vector<Token> tokens = lexer.tokenize();
 
     ThreeAddressCodeGenerator tac;
-    Parser parser(tokens, tac);
+    Parser parser(lexer, tac);
     parser.parseProgram();
 
     cout << "Three-Address Code:" << endl;
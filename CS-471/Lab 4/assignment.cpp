@@ -1,8 +1,9 @@
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <string>
 #include <vector>
 #include <unordered_set>
-#include <regex>
 
 using namespace std;
 
@@ -34,13 +35,10 @@ private:
     unordered_set<char> delimiters = {';', '(', ')', '{', '}', ','};
 
     vector<Token> tokens;
-    
-    // Regular expressions for matching different types
-    regex numberRegex = regex(R"(\d+(\.\d*)?)");
-    regex identifierRegex = regex(R"([A-Za-z_]\w*)");
-    regex operatorRegex = regex(R"([+\-*/=!<>]+)");
-    regex stringRegex = regex(R"("[^"]*")");
-    
+
+    // Longest entry in operators; a longer run of operator characters can never be an operator
+    static const size_t MAX_OPERATOR_LENGTH = 2;
+
     // Helper function to check if a string is a keyword
     bool isKeyword(const string& str) {
         return keywords.find(str) != keywords.end();
@@ -56,76 +54,99 @@ private:
         return delimiters.find(ch) != delimiters.end();
     }
 
+    // Helper function to check if a char can be part of an operator ([+\-*/=!<>])
+    static bool isOperatorChar(char ch) {
+        switch (ch) {
+            case '+': case '-': case '*': case '/':
+            case '=': case '!': case '<': case '>':
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Helper function to check if a char can continue an identifier (\w)
+    static bool isWordChar(char ch) {
+        return isalnum(ch) || ch == '_';
+    }
+
 public:
     // Tokenizer function
+    // Scans the code once from left to right. Every pattern is matched at the current position by
+    // looking at the characters directly, so no substrings are copied and each character is examined
+    // a bounded number of times.
     vector<Token> tokenize(const string& code) {
         size_t pos = 0;
-        while (pos < code.size()) {
+        const size_t n = code.size();
+        while (pos < n) {
+            char ch = code[pos];
+
             // Skip whitespace
-            if (isspace(code[pos])) {
+            if (isspace(ch)) {
                 pos++;
                 continue;
             }
 
-            // Match numbers
-            if (isdigit(code[pos])) {
-                smatch match;
-                string remainingCode = code.substr(pos);
-                if (regex_search(remainingCode, match, numberRegex)) {
-                    tokens.emplace_back(TokenType::NUMBER, match.str());
-                    pos += match.length();
-                    continue;
+            // Match numbers: \d+(\.\d*)?
+            if (isdigit(ch)) {
+                size_t start = pos;
+                while (pos < n && isdigit(code[pos])) pos++;
+                if (pos < n && code[pos] == '.') {
+                    pos++;
+                    while (pos < n && isdigit(code[pos])) pos++;
                 }
+                tokens.emplace_back(TokenType::NUMBER, code.substr(start, pos - start));
+                continue;
             }
 
-            // Match identifiers and keywords
-            if (isalpha(code[pos]) || code[pos] == '_') {
-                smatch match;
-                string remainingCode = code.substr(pos);
-                if (regex_search(remainingCode, match, identifierRegex)) {
-                    string value = match.str();
-                    if (isKeyword(value)) {
-                        tokens.emplace_back(TokenType::KEYWORD, value);
-                    } else {
-                        tokens.emplace_back(TokenType::IDENTIFIER, value);
-                    }
-                    pos += match.length();
-                    continue;
+            // Match identifiers and keywords: [A-Za-z_]\w*
+            if (isalpha(ch) || ch == '_') {
+                size_t start = pos;
+                while (pos < n && isWordChar(code[pos])) pos++;
+                string value = code.substr(start, pos - start);
+                if (isKeyword(value)) {
+                    tokens.emplace_back(TokenType::KEYWORD, value);
+                } else {
+                    tokens.emplace_back(TokenType::IDENTIFIER, value);
                 }
+                continue;
             }
 
-            // Match operators
-            smatch match;
-            string remainingCode = code.substr(pos);
-            if (regex_search(remainingCode, match, operatorRegex)) {
-                string value = match.str();
-                if (isOperator(value)) {
-                    tokens.emplace_back(TokenType::OPERATOR, value);
-                    pos += match.length();
-                    continue;
+            // Match operators: the whole run of operator characters must be a known operator.
+            // The run is only measured up to MAX_OPERATOR_LENGTH + 1 characters, which is enough
+            // to reject it and keeps long runs like "=====" linear.
+            if (isOperatorChar(ch)) {
+                size_t end = pos;
+                while (end < n && end - pos <= MAX_OPERATOR_LENGTH && isOperatorChar(code[end])) end++;
+                if (end - pos <= MAX_OPERATOR_LENGTH) {
+                    string value = code.substr(pos, end - pos);
+                    if (isOperator(value)) {
+                        tokens.emplace_back(TokenType::OPERATOR, value);
+                        pos = end;
+                        continue;
+                    }
                 }
             }
 
             // Match delimiters
-            if (isDelimiter(code[pos])) {
-                tokens.emplace_back(TokenType::DELIMITER, string(1, code[pos]));
+            if (isDelimiter(ch)) {
+                tokens.emplace_back(TokenType::DELIMITER, string(1, ch));
                 pos++;
                 continue;
             }
 
-            // Match string literals
-            if (code[pos] == '"') {
-                smatch match;
-                string remainingCode = code.substr(pos);
-                if (regex_search(remainingCode, match, stringRegex)) {
-                    tokens.emplace_back(TokenType::STRING, match.str());
-                    pos += match.length();
+            // Match string literals: "[^"]*"
+            if (ch == '"') {
+                size_t close = code.find('"', pos + 1);
+                if (close != string::npos) {
+                    tokens.emplace_back(TokenType::STRING, code.substr(pos, close - pos + 1));
+                    pos = close + 1;
                     continue;
                 }
             }
 
             // Unexpected character
-            cout << "Unexpected character: " << code[pos] << endl;
+            cout << "Unexpected character: " << ch << endl;
             pos++;
         }
 
@@ -165,8 +186,19 @@ public:
 };
 
 // Main function to demonstrate the tokenizer
-int main() {
+// With a file argument the file is tokenized instead of the built-in example.
+int main(int argc, char* argv[]) {
     string code = R"(if (x == 10) { return x + 2; })";
+    if (argc > 1) {
+        ifstream file(argv[1]);
+        if (!file) {
+            cerr << "Cannot open " << argv[1] << endl;
+            return 1;
+        }
+        stringstream buffer;
+        buffer << file.rdbuf();
+        code = buffer.str();
+    }
 
     Tokenizer tokenizer;
     vector<Token> tokens = tokenizer.tokenize(code);
@@ -0,0 +1,22 @@
+#!/bin/sh
+# Scaling benchmark for the Lab 4 tokenizer: builds assignment.cpp, tokenizes generated inputs from
+# 1 KB to 100 MB (a line of mixed tokens repeated) and prints the wall time for each size. The time
+# should grow linearly with the size; the token listing goes to /dev/null.
+# Usage: sh scale.sh [MAX_KB]        (102400 by default; CXX picks the compiler, g++ by default)
+cd "$(dirname "$0")" || exit 1
+MAX_KB=${1:-102400}
+CXX=${CXX:-g++}
+work=$(mktemp -d) || exit 1
+trap 'rm -rf "$work"' EXIT
+$CXX -std=c++17 -O2 -o "$work/assignment" ../assignment.cpp || exit 1
+
+line='if (x_1 >= 10.5) { total = total + "a b" * 3; } else return y != 0;'
+printf '%10s %12s\n' "size" "time (ms)"
+for kb in 1 10 100 1024 10240 102400; do
+    [ "$kb" -gt "$MAX_KB" ] && break
+    awk -v line="$line" -v bytes=$((kb * 1024)) 'BEGIN { n = int(bytes / (length(line) + 1)); for (i = 0; i < n; i++) print line }' > "$work/input.txt"
+    start=$(date +%s%N)
+    "$work/assignment" "$work/input.txt" > /dev/null || exit 1
+    end=$(date +%s%N)
+    printf '%8s KB %12s\n' "$kb" $(((end - start) / 1000000))
+done
@@ -0,0 +1,20 @@
+#!/bin/sh
+# Regression tests for the Lab 4 tokenizer: builds assignment.cpp, runs it on every *.txt file here and
+# compares the tokens it prints with the matching .expected file.
+# Usage: sh run_tests.sh        (CXX picks the compiler, g++ by default)
+cd "$(dirname "$0")" || exit 1
+CXX=${CXX:-g++}
+work=$(mktemp -d) || exit 1
+trap 'rm -rf "$work"' EXIT
+$CXX -std=c++17 -O2 -o "$work/assignment" ../assignment.cpp || exit 1
+
+failed=0
+for input in *.txt; do
+    if ! "$work/assignment" "$input" | diff -u "${input%.txt}.expected" - > "$work/diff"; then
+        echo "FAIL: $input"
+        cat "$work/diff"
+        failed=$((failed + 1))
+    fi
+done
+echo "$(ls *.txt | wc -l) tests, $failed failed"
+[ "$failed" -eq 0 ]
@@ -1,74 +1,121 @@
 #include <iostream>
-#include <fstream>
+#include <cstdio>
 #include <string>
+#include <string_view>
 #include <cctype>
 #include <unordered_set>
+#include <chrono>
 
 using namespace std;
 
 // Define keywords and symbols
-unordered_set<string> keywords = {"int", "float", "return", "if", "else", "switch", ""};
-unordered_set<char> symbols = {'(', ')', '{', '}', ';', ','};
+unordered_set<string_view> keywords = {"int", "float", "return", "if", "else", "switch", ""};
+const string_view symbols = "(){};,";
 
-void tokenize(const string& filename) {
-    ifstream file(filename);
-    if (!file.is_open()) {
+const size_t READ_BLOCK_SIZE = 1 << 20;   // bytes read from the file per fread
+const size_t OUTPUT_BUFFER_SIZE = 1 << 20; // bytes collected before one fwrite
+
+// Collects the output lines and writes them with one fwrite when the buffer is full and once at the end,
+// instead of flushing after every token.
+class OutputBuffer {
+public:
+    OutputBuffer() {
+        buffer.reserve(OUTPUT_BUFFER_SIZE);
+    }
+
+    ~OutputBuffer() {
+        flush();
+    }
+
+    void line(string_view label, string_view text) {
+        if (buffer.size() + label.size() + text.size() + 1 > OUTPUT_BUFFER_SIZE) flush();
+        buffer.append(label).append(text).push_back('\n');
+    }
+
+    void flush() {
+        fwrite(buffer.data(), 1, buffer.size(), stdout);
+        buffer.clear();
+    }
+
+private:
+    string buffer;
+};
+
+/*
+    Reads the file in READ_BLOCK_SIZE blocks and classifies the tokens in place in each block:
+    - A run of alphanumeric characters is handled as a whole. When a symbol or operator follows it in the
+      same block it is printed straight from the block; otherwise it is kept in pending, because spaces do
+      not end a word here (only a symbol, an operator or the end of the file does) and the word may go on
+      after them or in the next block.
+    Returns the number of tokens printed.
+*/
+size_t tokenize(const string& filename) {
+    FILE *file = fopen(filename.c_str(), "rb");
+    if (!file) {
         cout << "Error opening file!" << endl;
-        return;
+        return 0;
     }
 
-    string token;
-    char ch;
-    while (file.get(ch)) {
-        // Ignore spaces
-        if (isspace(ch)) continue;
-
-        // Handle symbols
-        if (symbols.count(ch)) {
-            if (!token.empty()) {
-                // If there is a token before the symbol, process it
-                if (keywords.count(token)) {
-                    cout << "Keyword: " << token << endl;
-                } else {
-                    cout << "Identifier: " << token << endl;
-                }
-                token.clear();
+    OutputBuffer out;
+    size_t tokenCount = 0;
+    auto printWord = [&](string_view word) {
+        out.line(keywords.count(word) ? "Keyword: " : "Identifier: ", word);
+        tokenCount++;
+    };
+
+    string pending;
+    string block(READ_BLOCK_SIZE, '\0');
+    size_t n;
+    while ((n = fread(&block[0], 1, block.size(), file)) > 0) {
+        const char *data = block.data();
+        size_t i = 0;
+        while (i < n) {
+            unsigned char ch = data[i];
+
+            // Ignore spaces
+            if (isspace(ch)) {
+                i++;
+                continue;
             }
-            cout << "Symbol: " << ch << endl;
-            continue;
-        }
 
-        // Handle alphanumeric tokens (keywords/identifiers)
-        if (isalnum(ch)) {
-            token += ch;
-        } else {
-            if (!token.empty()) {
-                // If a non-alphanumeric character is found after a token, print it
-                if (keywords.count(token)) {
-                    cout << "Keyword: " << token << endl;
+            // Handle alphanumeric tokens (keywords/identifiers)
+            if (isalnum(ch)) {
+                size_t start = i;
+                while (i < n && isalnum((unsigned char)data[i])) i++;
+                if (pending.empty() && i < n && !isspace((unsigned char)data[i])) {
+                    printWord(string_view(data + start, i - start));
                 } else {
-                    cout << "Identifier: " << token << endl;
+                    pending.append(data + start, i - start);
                 }
-                token.clear();
+                continue;
+            }
+
+            // A symbol or operator ends the pending word
+            if (!pending.empty()) {
+                printWord(pending);
+                pending.clear();
             }
-            cout << "Operator: " << ch << endl;
+            out.line(symbols.find(ch) != string_view::npos ? "Symbol: " : "Operator: ", string_view(data + i, 1));
+            tokenCount++;
+            i++;
         }
     }
 
     // If there's a leftover token at the end of the file
-    if (!token.empty()) {
-        if (keywords.count(token)) {
-            cout << "Keyword: " << token << endl;
-        } else {
-            cout << "Identifier: " << token << endl;
-        }
-    }
+    if (!pending.empty()) printWord(pending);
 
-    file.close();
+    fclose(file);
+    return tokenCount;
 }
 
-int main() {
-    string filename = "file.txt";  // Your file name here
-    tokenize(filename);
+int main(int argc, char *argv[]) {
+    string filename = argc > 1 ? argv[1] : "file.txt";  // Your file name here (or pass it as the first argument)
+
+    auto start = chrono::steady_clock::now();
+    size_t tokenCount = tokenize(filename);
+    fflush(stdout);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cerr << tokenCount << " tokens in " << seconds << " s (" << (seconds > 0 ? tokenCount / seconds : 0) << " tokens/sec)" << endl;
     return 0;
 }
@@ -99,10 +99,7 @@ class Parser {
  
 
 public:
-    Parser(const vector<Token> &tokens) {
-        this->tokens = tokens;  
-        this->pos = 0;          
-    }
+    Parser(const vector<Token> &tokens) : tokens(tokens), pos(0) {}
 
     void parseProgram() {
         while (tokens[pos].type != T_EOF) {
@@ -112,7 +109,7 @@ public:
     }
 
 private:
-    vector<Token> tokens;
+    const vector<Token> &tokens; // borrowed, not copied: the caller keeps the vector alive while parsing
     size_t pos;
 
     void parseStatement() {
@@ -4,6 +4,18 @@
 #include <cctype>
 #include <map>
 #include <fstream>
+#include <string_view>
+#include <algorithm>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
@@ -18,14 +30,150 @@ enum TokenType {
 struct Token {
     TokenType type;
     string value;
+    int line;
+};
+
+/*
+    DiagnosticSink collects the errors found in one source file instead of stopping at the first one.
+    The lexer and the parser report into it and carry on, so a single run (and a single process for a
+    whole batch of files) reports every error, each with its line number.
+*/
+struct Diagnostic {
+    int line;
+    string message;
+};
+
+class DiagnosticSink {
+public:
+    void error(int line, const string &message) {
+        diagnostics.push_back(Diagnostic{line, message});
+    }
+
+    bool hasErrors() const {
+        return !diagnostics.empty();
+    }
+
+    // Prints every diagnostic as "file:line: message", in line order (the lexer's errors are
+    // collected before the parser's).
+    void print(ostream &out, const string &filename) {
+        stable_sort(diagnostics.begin(), diagnostics.end(), [](const Diagnostic &a, const Diagnostic &b) {
+            return a.line < b.line;
+        });
+        for (const Diagnostic &d : diagnostics) {
+            out << filename << ":" << d.line << ": " << d.message << "\n";
+        }
+    }
+
+    size_t count() const {
+        return diagnostics.size();
+    }
+
+private:
+    vector<Diagnostic> diagnostics;
+};
+
+/*
+    SourceBuffer holds the text of the program being compiled.
+    Regular files are memory-mapped read-only, so the operating system pages the file in as the lexer
+    walks over it and nothing is copied. Pipes, character devices and stdin ("-") cannot be mapped,
+    so for those the bytes are read in large blocks into an owned string instead.
+    The Lexer only keeps a string_view of the buffer, so the buffer must outlive the Lexer.
+*/
+class SourceBuffer {
+public:
+    SourceBuffer() = default;
+    SourceBuffer(const SourceBuffer &) = delete;
+    SourceBuffer &operator=(const SourceBuffer &) = delete;
+
+    ~SourceBuffer() {
+#ifdef _WIN32
+        if (mapped) UnmapViewOfFile(data);
+#else
+        if (mapped) munmap(const_cast<char *>(data), size);
+#endif
+    }
+
+    bool open(const string &path) {
+        if (path == "-") {
+            return readAll(stdin);
+        }
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                  FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER fileSize;
+        if (GetFileType(file) == FILE_TYPE_DISK && GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+            HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (mapping != NULL) {
+                data = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                CloseHandle(mapping); // the view keeps the mapping alive
+                if (data != NULL) {
+                    size = static_cast<size_t>(fileSize.QuadPart);
+                    mapped = true;
+                    CloseHandle(file);
+                    return true;
+                }
+            }
+        }
+        CloseHandle(file);
+        FILE *in = fopen(path.c_str(), "rb");
+        if (!in) return false;
+        bool ok = readAll(in);
+        fclose(in);
+        return ok;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            void *addr = mmap(NULL, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                madvise(addr, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL); // lexing reads front to back
+                data = static_cast<const char *>(addr);
+                size = static_cast<size_t>(st.st_size);
+                mapped = true;
+                close(fd); // the mapping stays valid after the descriptor is closed
+                return true;
+            }
+        }
+        FILE *in = fdopen(fd, "rb");
+        if (!in) {
+            close(fd);
+            return false;
+        }
+        bool ok = readAll(in);
+        fclose(in);
+        return ok;
+#endif
+    }
+
+    string_view view() const {
+        return mapped ? string_view(data, size) : string_view(owned);
+    }
+
+private:
+    const char *data = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+    string owned; // used when the input could not be mapped
+
+    bool readAll(FILE *in) {
+        char block[1 << 16];
+        size_t n;
+        while ((n = fread(block, 1, sizeof(block), in)) > 0) {
+            owned.append(block, n);
+        }
+        return !ferror(in);
+    }
 };
 
 class Lexer {
 
     private:
-        string src;
+        string_view src; // view of a SourceBuffer, which owns (or maps) the bytes
         size_t pos;
         int line;
+        DiagnosticSink &diagnostics;
         /*
         It hold positive values. 
         In C++, size_t is an unsigned integer data type used to represent the 
@@ -34,9 +182,10 @@ class Lexer {
         */
 
     public:
-        Lexer(const string &src) {
+        Lexer(string_view src, DiagnosticSink &diagnostics) : diagnostics(diagnostics) {
             this->src = src;  
             this->pos = 0;    
+            this->line = 1;
         }
 
         vector<Token> tokenize() {
@@ -50,36 +199,37 @@ class Lexer {
                     continue;
                 }
                 if (isdigit(current)) {
-                    tokens.push_back(Token{T_NUM, consumeNumber()});
+                    tokens.push_back(Token{T_NUM, consumeNumber(), line});
                     continue;
                 }
                 if (isalpha(current)) {
                     string word = consumeWord();
-                    if (word == "int") tokens.push_back(Token{T_INT, word});
-                    else if (word == "if") tokens.push_back(Token{T_IF, word});
-                    else if (word == "else") tokens.push_back(Token{T_ELSE, word});
-                    else if (word == "return") tokens.push_back(Token{T_RETURN, word});
-                    else tokens.push_back(Token{T_ID, word});
+                    if (word == "int") tokens.push_back(Token{T_INT, word, line});
+                    else if (word == "if") tokens.push_back(Token{T_IF, word, line});
+                    else if (word == "else") tokens.push_back(Token{T_ELSE, word, line});
+                    else if (word == "return") tokens.push_back(Token{T_RETURN, word, line});
+                    else tokens.push_back(Token{T_ID, word, line});
                     continue;
                 }
                 
                 switch (current) {
-                        case '=': tokens.push_back(Token{T_ASSIGN, "="}); break;
-                        case '+': tokens.push_back(Token{T_PLUS, "+"}); break;
-                        case '-': tokens.push_back(Token{T_MINUS, "-"}); break;
-                        case '*': tokens.push_back(Token{T_MUL, "*"}); break;
-                        case '/': tokens.push_back(Token{T_DIV, "/"}); break;
-                        case '(': tokens.push_back(Token{T_LPAREN, "("}); break;
-                        case ')': tokens.push_back(Token{T_RPAREN, ")"}); break;
-                        case '{': tokens.push_back(Token{T_LBRACE, "{"}); break;  
-                        case '}': tokens.push_back(Token{T_RBRACE, "}"}); break;  
-                        case ';': tokens.push_back(Token{T_SEMICOLON, ";"}); break;
-                        case '>': tokens.push_back(Token{T_GT, ">"}); break;
-                        default: cout << "Unexpected character: " << current << endl; exit(1);
+                        case '=': tokens.push_back(Token{T_ASSIGN, "=", line}); break;
+                        case '+': tokens.push_back(Token{T_PLUS, "+", line}); break;
+                        case '-': tokens.push_back(Token{T_MINUS, "-", line}); break;
+                        case '*': tokens.push_back(Token{T_MUL, "*", line}); break;
+                        case '/': tokens.push_back(Token{T_DIV, "/", line}); break;
+                        case '(': tokens.push_back(Token{T_LPAREN, "(", line}); break;
+                        case ')': tokens.push_back(Token{T_RPAREN, ")", line}); break;
+                        case '{': tokens.push_back(Token{T_LBRACE, "{", line}); break;  
+                        case '}': tokens.push_back(Token{T_RBRACE, "}", line}); break;  
+                        case ';': tokens.push_back(Token{T_SEMICOLON, ";", line}); break;
+                        case '>': tokens.push_back(Token{T_GT, ">", line}); break;
+                        // Report the character and drop it; the parser sees the tokens around it.
+                        default: diagnostics.error(line, string("Unexpected character: ") + current); break;
                 }
                 pos++;
             }
-            tokens.push_back(Token{T_EOF, ""});
+            tokens.push_back(Token{T_EOF, "", line});
             return tokens;
         }
 
@@ -87,36 +237,75 @@ class Lexer {
         string consumeNumber() {
             size_t start = pos;
             while (pos < src.size() && isdigit(src[pos])) pos++;
-            return src.substr(start, pos - start);
+            return string(src.substr(start, pos - start));
         }
 
         string consumeWord() {
             size_t start = pos;
             while (pos < src.size() && isalnum(src[pos])) pos++;
-            return src.substr(start, pos - start);
+            return string(src.substr(start, pos - start));
         }
 };
 
 
+/*
+    Parser with panic-mode error recovery: a syntax error is reported to the DiagnosticSink and thrown
+    as a SyntaxError up to the nearest statement list (the program or a block). There the parser skips
+    tokens up to the next ';' (consumed) or '}' (left for the block to close) and goes on with the next
+    statement, so one syntax error does not hide the ones after it.
+*/
 class Parser {
  
 
 public:
-    Parser(const vector<Token> &tokens) {
-        this->tokens = tokens;  
-        this->pos = 0;          
-    }
+    Parser(const vector<Token> &tokens, DiagnosticSink &diagnostics) : tokens(tokens), pos(0), diagnostics(diagnostics) {}
 
-    void parseProgram() {
+    // Returns true if the program parsed without any error.
+    bool parseProgram() {
         while (tokens[pos].type != T_EOF) {
-            parseStatement();
+            if (tokens[pos].type == T_RBRACE) {
+                // A '}' without its '{' ends no block at the top level: skip it, reporting it unless the
+                // error that recovery stopped on was already reported at this token.
+                if (reportedAt != pos) syntaxError();
+                pos++;
+                continue;
+            }
+            parseStatementOrRecover();
         }
-        cout << "Parsing completed successfully! No Syntax Error" << endl;
+        return !diagnostics.hasErrors();
     }
 
 private:
-    vector<Token> tokens;
+    const vector<Token> &tokens; // borrowed, not copied: the caller keeps the vector alive while parsing
     size_t pos;
+    DiagnosticSink &diagnostics;
+    size_t reportedAt = SIZE_MAX; // position of the token the last diagnostic was reported at
+
+    struct SyntaxError {}; // thrown after the error has been reported, to unwind to the statement list
+
+    void parseStatementOrRecover() {
+        try {
+            parseStatement();
+        } catch (const SyntaxError &) {
+            synchronize();
+        }
+    }
+
+    // Skips to the end of the broken statement: past the next ';', or up to the next '}'.
+    void synchronize() {
+        while (tokens[pos].type != T_EOF && tokens[pos].type != T_RBRACE) {
+            if (tokens[pos++].type == T_SEMICOLON) return;
+        }
+    }
+
+    void syntaxError() {
+        report("Syntax error: unexpected token " + tokens[pos].value);
+    }
+
+    void report(const string &message) {
+        diagnostics.error(tokens[pos].line, message);
+        reportedAt = pos;
+    }
 
     void parseStatement() {
         if (tokens[pos].type == T_INT) {
@@ -130,15 +319,15 @@ private:
         } else if (tokens[pos].type == T_LBRACE) {  
             parseBlock();
         } else {
-            cout << "Syntax error: unexpected token " << tokens[pos].value << endl;
-            exit(1);
+            syntaxError();
+            throw SyntaxError{};
         }
     }
 
     void parseBlock() {
         expect(T_LBRACE);  
         while (tokens[pos].type != T_RBRACE && tokens[pos].type != T_EOF) {
-            parseStatement();
+            parseStatementOrRecover();
         }
         expect(T_RBRACE);  
     }
@@ -201,8 +390,8 @@ private:
             parseExpression();
             expect(T_RPAREN);
         } else {
-            cout << "Syntax error: unexpected token " << tokens[pos].value << endl;
-            exit(1);
+            syntaxError();
+            throw SyntaxError{};
         }
     }
 
@@ -210,31 +399,45 @@ private:
         if (tokens[pos].type == type) {
             pos++;
         } else {
-            cout << "Syntax error: expected " << type << " but found " << tokens[pos].value << endl;
-            exit(1);
+            report("Syntax error: expected " + to_string(type) + " but found " + tokens[pos].value);
+            throw SyntaxError{};
         }
     }
 };
 
+// Compiles one file and prints its diagnostics; returns false if it could not be read or had errors.
+bool compileFile(const string &filename, bool namePrefix) {
+    SourceBuffer input;
+    if (!input.open(filename)) {
+        cout << "Error opening file: " << filename << endl;
+        return false;
+    }
+
+    DiagnosticSink diagnostics;
+    Lexer lexer(input.view(), diagnostics);
+    vector<Token> tokens = lexer.tokenize();
+    
+    Parser parser(tokens, diagnostics);
+    if (parser.parseProgram()) {
+        cout << (namePrefix ? filename + ": " : "") << "Parsing completed successfully! No Syntax Error" << "\n";
+        return true;
+    }
+    diagnostics.print(cout, filename);
+    cout << filename << ": " << diagnostics.count() << " error(s)" << "\n";
+    return false;
+}
+
+// Every file named on the command line is compiled in this one process, and all of its errors are
+// reported; the exit status is 1 if any file failed.
 int main(int argc, char* argv[]) {
     if (argc < 2) {
-        cout << "Usage: ./compiler <filename>" << endl;
+        cout << "Usage: ./compiler <filename>...   (use - to read from stdin)" << endl;
         return 1;
     }
     
-    ifstream file(argv[1]);
-    if (!file) {
-        cout << "Error opening file: " << argv[1] << endl;
-        return 1;
+    bool ok = true;
+    for (int i = 1; i < argc; i++) {
+        ok = compileFile(argv[i], argc > 2) && ok;
     }
-
-    string input((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
-    
-    Lexer lexer(input);
-    vector<Token> tokens = lexer.tokenize();
-    
-    Parser parser(tokens);
-    parser.parseProgram();
-
-    return 0;
+    return ok ? 0 : 1;
 }
@@ -0,0 +1,2 @@
+int x;
+x = 5 @ 3;
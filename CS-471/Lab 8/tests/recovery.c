@@ -0,0 +1,5 @@
+int x;
+x = 5 + ;
+int y
+y = 3;
+if (x > 2) { y = y * 2; } else { return y; }
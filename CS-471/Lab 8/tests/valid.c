@@ -0,0 +1,7 @@
+int x;
+x = 10;
+if (x > 5) {
+    x = x - 1;
+} else {
+    return x;
+}
@@ -0,0 +1,61 @@
+// Benchmark driver for the parsers that borrow their token vector (Lab 6, Lab 11/compiler2.cpp, Lab 12
+// and Lab 14). It includes the lab source named by LAB_SOURCE, tokenizes the file given as the first
+// argument and reports how long constructing the Parser takes and the peak RSS before and after it.
+// borrow_tokens.sh builds it once against each source as it is and once against a copy whose Parser
+// owns its tokens again, so the two lines show what borrowing saves.
+#include <sys/resource.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+#define main labMain
+#include LAB_SOURCE
+#undef main
+
+// Peak resident set size of this process so far, in KB
+static long peakRssKb()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "Usage: " << argv[0] << " FILE" << endl;
+        return 1;
+    }
+    ifstream file(argv[1]);
+    if (!file)
+    {
+        cerr << "Cannot open " << argv[1] << endl;
+        return 1;
+    }
+    stringstream buffer;
+    buffer << file.rdbuf();
+
+    Lexer lexer(buffer.str());
+    vector<Token> tokens = lexer.tokenize();
+
+    long before = peakRssKb();
+    auto start = chrono::steady_clock::now();
+#if LAB == 12
+    SymbolTable symbolTable;
+    Parser parser(tokens, symbolTable);
+#elif LAB == 14
+    SymbolTable symTable;
+    IntermediateCodeGnerator icg;
+    Parser parser(tokens, symTable, icg);
+#else
+    Parser parser(tokens);
+#endif
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    long after = peakRssKb();
+    (void)parser;
+
+    cout << tokens.size() << " tokens, construct " << ms << " ms, peak RSS " << before / 1024 << " MB before the Parser, "
+         << after / 1024 << " MB after" << endl;
+    return 0;
+}
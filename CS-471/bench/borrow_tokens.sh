@@ -0,0 +1,30 @@
+#!/bin/sh
+# Benchmark for the parsers that borrow the caller's token vector instead of copying it: for Lab 6,
+# Lab 11/compiler2.cpp, Lab 12 and Lab 14 it builds borrow_tokens.cpp against the source as it is
+# ("borrow") and against a copy whose Parser owns a vector<Token> again ("copy"), runs both on a
+# generated input of SIZE_MB megabytes and prints the Parser construction time and peak RSS.
+# Usage: sh borrow_tokens.sh [SIZE_MB]        (45 by default; CXX picks the compiler, g++ by default)
+cd "$(dirname "$0")" || exit 1
+SIZE_MB=${1:-45}
+CXX=${CXX:-g++}
+work=$(mktemp -d) || exit 1
+trap 'rm -rf "$work"' EXIT
+
+awk -v bytes=$((SIZE_MB * 1024 * 1024)) 'BEGIN { line = "int x1; x1 = x1 + 10 * (x1 - 2);"; n = int(bytes / (length(line) + 1)); for (i = 0; i < n; i++) print line }' > "$work/input.c"
+
+for lab in "6 Lab 6/compiler.cpp" "11 Lab 11/compiler2.cpp" "12 Lab 12/compiler.cpp" "14 Lab 14/compiler.cpp"; do
+    number=${lab%% *}
+    source="../${lab#* }"
+    cp "$source" "$work/borrow.cpp"
+    sed 's|const vector<Token> &tokens; // borrowed.*|vector<Token> tokens;|' "$source" > "$work/copy.cpp"
+    if cmp -s "$work/borrow.cpp" "$work/copy.cpp"; then
+        echo "$source: no borrowed token vector found"
+        exit 1
+    fi
+    for variant in borrow copy; do
+        $CXX -std=c++17 -O2 -w -I"$(dirname "$source")" -DLAB="$number" -DLAB_SOURCE="\"$work/$variant.cpp\"" \
+            -o "$work/bench" borrow_tokens.cpp || exit 1
+        printf '%-24s %-6s ' "${lab#* }" "$variant"
+        "$work/bench" "$work/input.c" || exit 1
+    done
+done
@@ -0,0 +1,42 @@
+// Runs a command and prints its wall time and peak resident set size to stderr, for the benchmark
+// scripts (this sandbox-friendly stand-in for /usr/bin/time -v needs nothing but POSIX).
+// Usage: measure COMMAND [ARGS...]        exits with the command's status
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "Usage: " << argv[0] << " COMMAND [ARGS...]" << endl;
+        return 2;
+    }
+    auto start = chrono::steady_clock::now();
+    pid_t child = fork();
+    if (child < 0)
+    {
+        perror("fork");
+        return 2;
+    }
+    if (child == 0)
+    {
+        execvp(argv[1], argv + 1);
+        perror(argv[1]);
+        _exit(127);
+    }
+    int status;
+    rusage usage;
+    if (wait4(child, &status, 0, &usage) < 0)
+    {
+        perror("wait4");
+        return 2;
+    }
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cerr << ms << " ms, peak RSS " << usage.ru_maxrss / 1024 << " MB" << endl;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+}